@@ -0,0 +1,83 @@
+/*
+ * cjson_bench [--quick] [名称...]
+ * 不带名称时运行全部基准测试。
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "bench.hpp"
+#include "cJSON.hpp"
+
+bool bench::quick = false;
+
+static volatile const void *sink;
+
+void bench::consume(const void *p) {
+    sink = p;
+}
+
+void bench::report(const char *name, double ms, size_t bytes) {
+    if (bytes) printf("  %-44s %10.3f ms %9.1f MB/s\n", name, ms, bytes / ms / 1e3);
+    else printf("  %-44s %10.3f ms\n", name, ms);
+}
+
+void bench::report_ns(const char *name, double ms, size_t ops) {
+    printf("  %-44s %10.1f ns/op\n", name, ms * 1e6 / (double) ops);
+}
+
+std::string bench::sample_document(size_t records, unsigned seed) {
+    static const char *words[] = {"alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta"};
+    std::mt19937 rng(seed);
+    std::string out = "[";
+    char buf[256];
+    for (size_t i = 0; i < records; i++) {
+        snprintf(buf, sizeof(buf),
+                 "%s{\"id\":%zu,\"name\":\"%s %s\",\"score\":%.6g,\"active\":%s,\"tags\":[\"%s\",\"%s\"],"
+                 "\"pos\":{\"x\":%d,\"y\":%d,\"z\":%.3f},\"note\":null}",
+                 i ? "," : "", i * 7919 + rng() % 1000, words[rng() % 8], words[rng() % 8],
+                 (double) rng() / 1e6, rng() & 1 ? "true" : "false", words[rng() % 8], words[rng() % 8],
+                 (int) (rng() % 2000) - 1000, (int) (rng() % 2000) - 1000, (double) (rng() % 100000) / 7.0);
+        out += buf;
+    }
+    out += "]";
+    return out;
+}
+
+std::string bench::formatted(const std::string &json) {
+    cJSON *root = cJSON_ParseWithLength(json.data(), json.size());
+    char *text = cJSON_Print(root);
+    std::string out = text;
+    free(text);
+    cJSON_Delete(root);
+    return out;
+}
+
+static const struct {
+    const char *name;
+    void (*run)();
+} benches[] = {
+        {"whitespace", bench_whitespace},
+        {"numbers", bench_numbers},
+        {"lookup", bench_lookup},
+        {"doc", bench_doc},
+        {"lazy", bench_lazy},
+        {"ndjson", bench_ndjson},
+};
+
+int main(int argc, char **argv) {
+    int selected = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--quick")) bench::quick = true;
+        else selected++;
+    }
+    for (const auto &b : benches) {
+        bool run = !selected;
+        for (int i = 1; i < argc && !run; i++) run = !strcmp(argv[i], b.name);
+        if (!run) continue;
+        printf("%s\n", b.name);
+        b.run();
+    }
+    return 0;
+}
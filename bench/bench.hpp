@@ -0,0 +1,60 @@
+/*
+ * 基准测试的公用工具：计时、生成测试文档、输出结果。
+ * 每组基准测试是一个 bench_xxx() 函数，在 bench.cpp 的表中登记。
+ */
+#ifndef CJSON_BENCH_HPP
+#define CJSON_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace bench {
+
+/* 为真时缩小数据规模、减少重复次数，用于 ctest 冒烟测试 */
+extern bool quick;
+
+/* 按 quick 缩小后的规模 */
+inline size_t scaled(size_t n) {
+	return quick ? n / 16 + 1 : n;
+}
+
+/* 重复运行 f，返回最短的一次耗时（毫秒） */
+template<typename F>
+double best_ms(F &&f) {
+	double best = 1e300;
+	for (int run = 0, runs = quick ? 2 : 9; run < runs; run++) {
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto stop = std::chrono::steady_clock::now();
+		double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+		if (ms < best) best = ms;
+	}
+	return best;
+}
+
+/* 输出一行结果；bytes 为 0 时不输出吞吐量 */
+void report(const char *name, double ms, size_t bytes = 0);
+
+/* 输出每次操作的纳秒数 */
+void report_ns(const char *name, double ms, size_t ops);
+
+/* 生成由 records 条记录组成的数组，记录混合了整数、浮点数、字符串、数组和嵌套对象，结果为紧凑格式 */
+std::string sample_document(size_t records, unsigned seed = 1);
+
+/* 把紧凑格式的文档重新输出为带缩进的格式 */
+std::string formatted(const std::string &json);
+
+/* 防止被测代码被优化掉 */
+void consume(const void *p);
+
+}
+
+void bench_whitespace();
+void bench_numbers();
+void bench_lookup();
+void bench_doc();
+void bench_lazy();
+void bench_ndjson();
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * 紧凑文档与 cJSON 树比较：解析耗时、每个值占用的字节数（峰值和解析后保留的），以及完整遍历的耗时。
+ * 内存通过 cJSON_InitHooks 计数，只在测量时装上；另外列出原来按 length / 2 + 1 个节点加 length + 1
+ * 字节字符池一次预留的大小作参照。
+ */
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "bench.hpp"
+#include "cJSON.hpp"
+
+static size_t live_bytes, peak_bytes;
+
+/* 在块前面记下大小，释放时从计数中减去 */
+static void *counting_malloc(size_t size) {
+    size_t *block = (size_t *) malloc(size + 16);
+    if (!block) return NULL;
+    *block = size;
+    live_bytes += size;
+    if (live_bytes > peak_bytes) peak_bytes = live_bytes;
+    return (char *) block + 16;
+}
+
+static void counting_free(void *ptr) {
+    size_t *block;
+    if (!ptr) return;
+    block = (size_t *) ((char *) ptr - 16);
+    live_bytes -= *block;
+    free(block);
+}
+
+static void begin_counting() {
+    cJSON_Hooks hooks = {counting_malloc, counting_free};
+    live_bytes = peak_bytes = 0;
+    cJSON_InitHooks(&hooks);
+}
+
+static double sum_tree(const cJSON *item) {
+    double sum = 0;
+    for (; item; item = item->next) {
+        if (item->string) sum += strlen(item->string);
+        if (item->type & cJSON_Number) sum += item->valuedouble;
+        else if (item->valuestring) sum += strlen(item->valuestring);
+        else if (item->child) sum += sum_tree(item->child);
+    }
+    return sum;
+}
+
+static double sum_doc(const cJSON_Doc *doc, size_t ref) {
+    double sum = 0;
+    size_t length;
+    for (; ref != cJSON_DocNone; ref = cJSON_DocNext(doc, ref)) {
+        if (cJSON_DocKey(doc, ref, &length)) sum += length;
+        switch (cJSON_DocType(doc, ref)) {
+        case cJSON_Number: sum += cJSON_DocNumber(doc, ref); break;
+        case cJSON_String: cJSON_DocString(doc, ref, &length); sum += length; break;
+        case cJSON_Array:
+        case cJSON_Object: sum += sum_doc(doc, cJSON_DocChild(doc, ref)); break;
+        default: break;
+        }
+    }
+    return sum;
+}
+
+static size_t count_items(const cJSON *item) {
+    size_t n = 0;
+    for (; item; item = item->next) n += 1 + count_items(item->child);
+    return n;
+}
+
+static void run(const char *name, const std::string &json) {
+    size_t values, tree_peak, tree_kept, doc_peak, doc_kept;
+    double ms, sum = 0;
+    cJSON *tree;
+    cJSON_Doc *doc;
+
+    begin_counting();
+    tree = cJSON_ParseWithLength(json.data(), json.size());
+    tree_peak = peak_bytes;
+    tree_kept = live_bytes;
+    values = count_items(tree);
+    cJSON_Delete(tree);
+    begin_counting();
+    doc = cJSON_ParseDoc(json.data(), json.size());
+    doc_peak = peak_bytes;
+    doc_kept = live_bytes;
+    cJSON_DeleteDoc(doc);
+    cJSON_InitHooks(NULL);
+
+    printf(" %s: %zu bytes, %zu values\n", name, json.size(), values);
+    printf("  %-40s %8.1f peak, %8.1f kept bytes/value\n", "cJSON tree", (double) tree_peak / values,
+           (double) tree_kept / values);
+    printf("  %-40s %8.1f peak, %8.1f kept bytes/value\n", "compact doc", (double) doc_peak / values,
+           (double) doc_kept / values);
+    printf("  %-40s %8.1f bytes/value\n", "compact doc, old up-front reservation",
+           (double) ((json.size() / 2 + 1) * 16 + json.size() + 1) / values);
+
+    ms = bench::best_ms([&] { cJSON_Delete(cJSON_ParseWithLength(json.data(), json.size())); });
+    bench::report("parse + delete, cJSON tree", ms, json.size());
+    ms = bench::best_ms([&] { cJSON_DeleteDoc(cJSON_ParseDoc(json.data(), json.size())); });
+    bench::report("parse + delete, compact doc", ms, json.size());
+
+    tree = cJSON_ParseWithLength(json.data(), json.size());
+    doc = cJSON_ParseDoc(json.data(), json.size());
+    ms = bench::best_ms([&] { sum += sum_tree(tree); });
+    bench::report_ns("traverse, cJSON tree, per value", ms, values);
+    ms = bench::best_ms([&] { sum += sum_doc(doc, 0); });
+    bench::report_ns("traverse, compact doc, per value", ms, values);
+    bench::consume(&sum);
+    cJSON_DeleteDoc(doc);
+    cJSON_Delete(tree);
+}
+
+void bench_doc() {
+    std::string numbers = "[";
+    for (size_t i = 0, n = bench::scaled(200000); i < n; i++) numbers.append(i ? "," : "").append(std::to_string(i * 7919 % 100003));
+    numbers += "]";
+    run("records", bench::sample_document(bench::scaled(20000)));
+    run("records, indented", bench::formatted(bench::sample_document(bench::scaled(20000))));
+    run("integer array", numbers);
+}
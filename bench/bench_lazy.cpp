@@ -0,0 +1,62 @@
+/*
+ * 按需解析：在 cJSON_ParseLazy 得到的数组中取一条记录的一个成员。每次查询展开一条还没展开过的记录，
+ * 读的是这条记录的字节，因此每次查询的耗时应随记录大小增长、与整个文档的大小无关。
+ * 记录数和每条记录的大小分别变化；完整解析后再查询作参照，它的耗时随文档大小增长。
+ */
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "cJSON.hpp"
+
+/* records 条记录，每条的 payload 有 width 个数，查询的 name 放在 payload 之后，展开时必须跳过它 */
+static std::string make_document(size_t records, size_t width) {
+    std::string json = "[";
+    for (size_t i = 0; i < records; i++) {
+        json.append(i ? ",{\"id\":" : "{\"id\":").append(std::to_string(i)).append(",\"payload\":[");
+        for (size_t k = 0; k < width; k++) json.append(k ? "," : "").append(std::to_string((i + k) * 7919 % 100003));
+        json.append("],\"name\":\"r").append(std::to_string(i)).append("\"}");
+    }
+    return json.append("]");
+}
+
+static void run(size_t records, size_t width) {
+    const std::string json = make_document(records, width);
+    const size_t queries = records < bench::scaled(256) ? records : bench::scaled(256);
+    std::vector<cJSON *> trees;
+    size_t next = 0, found = 0;
+    char label[64];
+    double ms;
+
+    // best_ms 每轮都要没展开过的记录，先为每一轮解析一棵惰性树；顶层数组的索引预先建好，不计入查询
+    for (int i = 0; i < 9; i++) {
+        trees.push_back(cJSON_ParseLazy(json.data(), json.size()));
+        cJSON_BuildArrayIndex(trees.back());
+    }
+    printf(" %zu records, %zu bytes/record, %zu bytes\n", records, json.size() / records, json.size());
+    ms = bench::best_ms([&] {
+        cJSON *root = trees[next++ % trees.size()];
+        for (size_t q = 0; q < queries; q++)
+            found += cJSON_GetObjectItem(cJSON_GetArrayItem(root, (int) (q * (records / queries))), "name") != NULL;
+    });
+    snprintf(label, sizeof(label), "lazy query, %zu bytes read", json.size() / records);
+    bench::report_ns(label, ms, queries);
+    ms = bench::best_ms([&] { cJSON_Delete(cJSON_ParseLazy(json.data(), json.size())); });
+    bench::report("ParseLazy (skips the whole document)", ms, json.size());
+    ms = bench::best_ms([&] {
+        cJSON *root = cJSON_ParseWithLength(json.data(), json.size());
+        found += cJSON_GetObjectItem(cJSON_GetArrayItem(root, (int) records / 2), "name") != NULL;
+        cJSON_Delete(root);
+    });
+    bench::report("full parse + one query", ms, json.size());
+
+    bench::consume(&found);
+    for (cJSON *root : trees) cJSON_Delete(root);
+}
+
+void bench_lazy() {
+    for (size_t width : {4, 64, 1024}) {
+        for (size_t records : {bench::scaled(256), bench::scaled(4096)}) run(records, width);
+    }
+}
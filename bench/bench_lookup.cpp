@@ -0,0 +1,83 @@
+/*
+ * 对象成员查找：成员数从 10 到 100k。
+ * 没有索引的线性查找用 arena 中的对象测量（arena 中的对象不会自动建立索引），
+ * 原来的实现用逐成员 strcasecmp 的链表遍历作参照；另外给出建立索引的耗时，
+ * 与线性查找比较即可检查 CJSON_INDEX_LAZY_THRESHOLD 的取值。
+ */
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "cJSON.hpp"
+
+/* 原来的 cJSON_GetObjectItem：遍历链表，每个字符都调用 tolower */
+static cJSON *baseline_lookup(const cJSON *object, const char *key) {
+    cJSON *c = object->child;
+    for (; c; c = c->next) {
+        const unsigned char *a = (const unsigned char *) c->string, *b = (const unsigned char *) key;
+        for (; tolower(*a) == tolower(*b); a++, b++)
+            if (!*a) return c;
+        if (tolower(*a) == tolower(*b)) return c;
+    }
+    return NULL;
+}
+
+static void run(size_t members) {
+    std::mt19937 rng((unsigned) members);
+    std::vector<std::string> names;
+    std::vector<cJSON_Key> keys;
+    std::string json = "{", label;
+    cJSON_Arena *arena = cJSON_CreateArena(1 << 20);
+    cJSON *linear, *indexed;
+    size_t ops = bench::scaled(200000), found = 0;
+    size_t linear_ops = std::min(ops, bench::scaled(4000000) / members + 1);  // 线性查找在大对象上很慢，减少次数
+    double ms;
+
+    for (size_t i = 0; i < members; i++) {
+        names.push_back("member_" + std::to_string(i * 2654435761u % 1000003));
+        json += (i ? ",\"" : "\"") + names.back() + "\":" + std::to_string(i);
+    }
+    json += "}";
+    std::vector<size_t> order(ops);
+    for (size_t &i : order) i = rng() % members;
+    for (const std::string &name : names) keys.push_back(cJSON_PrepareKey(name.c_str()));
+    linear = cJSON_ParseWithArena(arena, json.c_str());
+    indexed = cJSON_Parse(json.c_str());
+    printf(" %zu members\n", members);
+
+    ms = bench::best_ms([&] {
+        for (size_t n = 0; n < linear_ops; n++) found += baseline_lookup(linear, names[order[n]].c_str()) != NULL;
+    });
+    bench::report_ns("baseline strcasecmp walk", ms, linear_ops);
+    ms = bench::best_ms([&] {
+        for (size_t n = 0; n < linear_ops; n++) found += cJSON_GetObjectItem(linear, names[order[n]].c_str()) != NULL;
+    });
+    bench::report_ns("GetObjectItem, no index", ms, linear_ops);
+    ms = bench::best_ms([&] {
+        for (size_t n = 0; n < linear_ops; n++) found += cJSON_GetObjectItemByKey(linear, &keys[order[n]]) != NULL;
+    });
+    bench::report_ns("GetObjectItemByKey, no index", ms, linear_ops);
+
+    ms = bench::best_ms([&] {
+        cJSON_DropObjectIndex(indexed);
+        cJSON_BuildObjectIndex(indexed);
+    });
+    bench::report_ns("BuildObjectIndex, per member", ms, members);
+    ms = bench::best_ms([&] { for (size_t i : order) found += cJSON_GetObjectItem(indexed, names[i].c_str()) != NULL; });
+    bench::report_ns("GetObjectItem, indexed", ms, ops);
+    ms = bench::best_ms([&] { for (size_t i : order) found += cJSON_GetObjectItemCaseSensitive(indexed, names[i].c_str()) != NULL; });
+    bench::report_ns("GetObjectItemCaseSensitive, indexed", ms, ops);
+    ms = bench::best_ms([&] { for (size_t i : order) found += cJSON_GetObjectItemByKey(indexed, &keys[i]) != NULL; });
+    bench::report_ns("GetObjectItemByKey, indexed", ms, ops);
+
+    bench::consume(&found);
+    cJSON_Delete(indexed);
+    cJSON_DeleteArena(arena);
+}
+
+void bench_lookup() {
+    for (size_t members : {10, 32, 100, 1000, 10000, 100000}) run(members);
+}
@@ -0,0 +1,61 @@
+/*
+ * NDJSON 吞吐量：cJSON_ParseNdjson 在不同线程数下的有序和无序模式，
+ * 以逐行 memchr + cJSON_ParseWithLength + cJSON_Delete 的串行循环作参照。
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "bench.hpp"
+#include "cJSON.hpp"
+
+static cJSON_bool count_record(cJSON *record, size_t, void *ctx) {
+    ((std::atomic<size_t> *) ctx)->fetch_add(record != NULL, std::memory_order_relaxed);
+    return 1;
+}
+
+/* sample_document 的每条记录占一行 */
+static std::string make_ndjson(size_t records) {
+    std::string out;
+    cJSON *root = cJSON_Parse(bench::sample_document(records).c_str());
+    for (cJSON *c = root->child; c; c = c->next) {
+        char *text = cJSON_PrintUnformatted(c);
+        out.append(text).push_back('\n');
+        free(text);
+    }
+    cJSON_Delete(root);
+    return out;
+}
+
+void bench_ndjson() {
+    const std::string text = make_ndjson(bench::scaled(400000));
+    const int cores = std::max(1, (int) std::thread::hardware_concurrency());
+    std::atomic<size_t> seen(0);
+    char label[64];
+    double ms;
+
+    printf(" %zu bytes, %d hardware threads\n", text.size(), cores);
+    ms = bench::best_ms([&] {
+        for (const char *line = text.data(), *end = line + text.size(), *nl; line < end; line = nl + 1) {
+            if (!(nl = (const char *) memchr(line, '\n', end - line))) nl = end;
+            cJSON *item = cJSON_ParseWithLength(line, nl - line);
+            seen += item != NULL;
+            cJSON_Delete(item);
+        }
+    });
+    bench::report("serial ParseWithLength loop", ms, text.size());
+    for (int threads : {1, 2, 4, cores}) {
+        for (cJSON_bool ordered : {0, 1}) {
+            ms = bench::best_ms([&] { cJSON_ParseNdjson(text.data(), text.size(), threads, ordered, count_record, &seen); });
+            snprintf(label, sizeof(label), "ParseNdjson, %d thread%s, %s", threads, threads > 1 ? "s" : "",
+                     ordered ? "ordered" : "unordered");
+            bench::report(label, ms, text.size());
+        }
+        if (threads >= cores) break;
+    }
+    bench::consume(&seen);
+}
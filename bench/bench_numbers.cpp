@@ -0,0 +1,126 @@
+/*
+ * 数字解析：整数为主和浮点数为主的数组。
+ * 转换部分与原来的实现（逐位乘 10 再乘 pow(10, e)）、strtod 和 std::from_chars 对比，
+ * 并统计原来的实现与 strtod 结果不一致（舍入错误）的比例。
+ * cJSON 的转换用 cJSON_KeepNumberText 保留原文，再由 cJSON_GetNumberValue() 逐个转换来单独计时。
+ */
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "cJSON.hpp"
+
+/* 原来的 parse_number，只保留转换部分 */
+static double baseline_number(const char *num) {
+    double n = 0, sign = 1, scale = 0;
+    int subscale = 0, signsubscale = 1;
+    if (*num == '-') sign = -1, num++;
+    while (*num == '0') num++;
+    if (*num >= '1' && *num <= '9') {
+        do { n = (n * 10.0) + (*num++ - '0'); }
+        while (*num >= '0' && *num <= '9');
+    }
+    if (*num == '.' && num[1] >= '0' && num[1] <= '9') {
+        num++;
+        while (*num >= '0' && *num <= '9') {
+            n = (n * 10.0) + (*num++ - '0');
+            scale--;
+        }
+    }
+    if (*num == 'E' || *num == 'e') {
+        num++;
+        if (*num == '+') num++;
+        else if (*num == '-') signsubscale = -1, num++;
+        while (*num >= '0' && *num <= '9') subscale = (subscale * 10) + (*num++ - '0');
+    }
+    return sign * n * pow(10.0, (scale + subscale * signsubscale));
+}
+
+static void run(const char *label, const std::vector<std::string> &lexemes) {
+    std::string json = "[", name;
+    std::vector<const char *> starts;
+    cJSON_Arena *arena = cJSON_CreateArena(1 << 20);
+    cJSON *raw, *item;
+    size_t n = lexemes.size(), wrong = 0;
+    double ms, sum = 0;
+
+    for (const std::string &lexeme : lexemes) {
+        if (json.size() > 1) json += ',';
+        json += lexeme;
+    }
+    json += ']';
+    for (const std::string &lexeme : lexemes) starts.push_back(lexeme.c_str());
+    printf(" %s (%zu numbers, %zu bytes)\n", label, n, json.size());
+
+    ms = bench::best_ms([&] {
+        bench::consume(cJSON_ParseWithArena(arena, json.c_str()));
+        cJSON_ResetArena(arena);
+    });
+    bench::report_ns("cJSON_ParseWithArena, whole array", ms, n);
+
+    raw = cJSON_ParseWithFlags(json.data(), json.size(), cJSON_KeepNumberText);
+    double walk = bench::best_ms([&] {     // 只遍历，作为扣除的基数
+        for (item = raw->child; item; item = item->next) {
+            item->valuedouble = NAN;
+            sum += item->valueint;
+        }
+    });
+    ms = bench::best_ms([&] {
+        for (item = raw->child; item; item = item->next) {
+            item->valuedouble = NAN;    // 让这次读取重新转换
+            sum += cJSON_GetNumberValue(item);
+        }
+    });
+    bench::report_ns("cJSON conversion only", ms - walk, n);
+    cJSON_Delete(raw);
+
+    ms = bench::best_ms([&] { for (const char *s : starts) sum += baseline_number(s); });
+    bench::report_ns("baseline n*10 + pow conversion", ms, n);
+    ms = bench::best_ms([&] { for (const char *s : starts) sum += strtod(s, NULL); });
+    bench::report_ns("strtod", ms, n);
+    ms = bench::best_ms([&] {
+        double d;
+        for (const std::string &s : lexemes) {
+            std::from_chars(s.data(), s.data() + s.size(), d);
+            sum += d;
+        }
+    });
+    bench::report_ns("std::from_chars", ms, n);
+
+    for (const char *s : starts) {
+        double a = baseline_number(s), b = strtod(s, NULL);
+        wrong += memcmp(&a, &b, sizeof(double)) != 0;
+    }
+    printf("  %-44s %10.2f %%\n", "baseline results that differ from strtod", 100.0 * wrong / n);
+    bench::consume(&sum);
+    cJSON_DeleteArena(arena);
+}
+
+void bench_numbers() {
+    std::mt19937_64 rng(4);
+    std::vector<std::string> ints, decimals, doubles;
+    size_t count = bench::scaled(1000000);
+    char buf[64];
+
+    for (size_t i = 0; i < count; i++) {
+        long long v = (long long) (rng() >> (rng() % 64));  // 位数均匀分布
+        ints.push_back(std::to_string(i & 1 ? -v : v));
+        snprintf(buf, sizeof(buf), "%.*f", (int) (rng() % 4) + 1, (double) (rng() % 2000000) / 100 - 10000);
+        decimals.push_back(buf);
+        double d;
+        do {
+            unsigned long long bits = rng();
+            memcpy(&d, &bits, sizeof(d));
+        } while (!std::isfinite(d));
+        snprintf(buf, sizeof(buf), "%.17g", d);
+        doubles.push_back(buf);
+    }
+    run("integers", ints);
+    run("short decimals", decimals);
+    run("17-digit doubles", doubles);
+}
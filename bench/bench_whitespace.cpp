@@ -0,0 +1,66 @@
+/*
+ * 空白跳过：同一份数据分别以带缩进和紧凑格式解析，两者之差就是解析器花在空白上的时间。
+ * 与 cjson_bench_scalar（以 CJSON_NO_SIMD 编译）的结果对比即可得到 SIMD 扫描的加速比。
+ */
+#include <string>
+
+#include "bench.hpp"
+#include "cJSON.hpp"
+
+/* 每层一个对象、缩进随深度增加的文档，空白占比远高于普通文档 */
+static std::string nested_document(size_t count, int depth) {
+    std::string out = "[";
+    for (size_t i = 0; i < count; i++) {
+        if (i) out += ",";
+        for (int d = 0; d < depth; d++) out += "{\"k\":[1,\"v\",";
+        out += "null";
+        for (int d = 0; d < depth; d++) out += "]}";
+    }
+    out += "]";
+    return out;
+}
+
+static size_t count_whitespace(const std::string &json) {
+    size_t n = 0;
+    for (unsigned char c : json) n += c <= 32;
+    return n;
+}
+
+/* 把缩进的 tab 换成 4 个空格，与常见的格式化工具输出一致 */
+static std::string indent_spaces(const std::string &json) {
+    std::string out;
+    for (char c : json) {
+        if (c == '\t') out += "    ";
+        else out += c;
+    }
+    return out;
+}
+
+static void run(const char *label, const std::string &minified, bool spaces4) {
+    std::string pretty = spaces4 ? indent_spaces(bench::formatted(minified)) : bench::formatted(minified);
+    cJSON_Arena *arena = cJSON_CreateArena(1 << 20);
+    size_t spaces = count_whitespace(pretty);
+    double times[2];
+    std::string name;
+
+    const std::string *inputs[] = {&minified, &pretty};
+    for (int i = 0; i < 2; i++) {
+        times[i] = bench::best_ms([&] {
+            bench::consume(cJSON_ParseWithArena(arena, inputs[i]->c_str()));
+            cJSON_ResetArena(arena);
+        });
+        name = std::string(label) + (i ? " formatted" : " minified");
+        bench::report(name.c_str(), times[i], inputs[i]->size());
+    }
+    printf("  %-44s %10.1f %%\n", "whitespace share of formatted input", 100.0 * spaces / pretty.size());
+    printf("  %-44s %10.2f ns\n", "extra time per whitespace byte", (times[1] - times[0]) * 1e6 / spaces);
+    cJSON_DeleteArena(arena);
+}
+
+void bench_whitespace() {
+    std::string records = bench::sample_document(bench::scaled(100000));
+    std::string nested = nested_document(bench::scaled(20000), 12);
+    run("records", records, false);
+    run("nested", nested, false);
+    run("nested, 4-space indent", nested, true);
+}
@@ -5,36 +5,284 @@
 #include <cmath>
 #include <cfloat>
 #include <climits>
+#include <cstdint>
+#include <charconv>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
 #include "cJSON.hpp"
 
-/* 错误信息 */
-static const char *ep;
+#if defined(__unix__) || defined(__APPLE__)
+#define CJSON_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* 定义 CJSON_NO_SIMD 时只使用逐字节扫描，用于对比测试 */
+#if !defined(CJSON_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define CJSON_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/* 错误信息，每个线程各自记录 */
+static thread_local const char *ep;
 
 const char *cJSON_GetErrorPtr(void) { return ep; }
 
-/* 给 cJSON 定义分配内存和释放内存的函数 */
-static void *(*cJSON_malloc)(size_t sz) = malloc;
+/* 全局的内存分配函数，由 cJSON_InitHooks 设置 */
+static void *(*global_malloc)(size_t sz) = malloc;
+
+static void (*global_free)(void *ptr) = free;
+
+struct cJSON_Context {
+    cJSON_Allocator allocator;
+    cJSON_Limits limits;
+    cJSON_Error error;          // 最近一次解析的结果
+};
 
-static void (*cJSON_free)(void *ptr) = free;
+/* 当前线程的上下文：由 cJSON_SetThreadContext 设置，*_Ctx 函数调用期间临时换成传入的上下文 */
+static thread_local cJSON_Context *thread_context;
+
+/* 所有内部分配都经过这两个函数：有当前上下文时用它的分配器，否则用全局的 */
+static void *cJSON_malloc(size_t size) {
+    const cJSON_Context *ctx = thread_context;
+    return ctx ? ctx->allocator.malloc_fn(size, ctx->allocator.userdata) : global_malloc(size);
+}
+
+static void cJSON_free(void *ptr) {
+    const cJSON_Context *ctx = thread_context;
+    if (ctx) ctx->allocator.free_fn(ptr, ctx->allocator.userdata);
+    else global_free(ptr);
+}
 
 /* 设置 cJSON 的内存分配函数 */
 [[maybe_unused]] void cJSON_InitHooks(cJSON_Hooks *hooks) {
     if (!hooks) { /* Reset hooks */
-        cJSON_malloc = malloc;
-        cJSON_free = free;
+        global_malloc = malloc;
+        global_free = free;
+        return;
+    }
+
+    global_malloc = (hooks->malloc_fn) ? hooks->malloc_fn : malloc;
+    global_free = (hooks->free_fn) ? hooks->free_fn : free;
+}
+
+/* 未指定分配器的上下文转用全局的内存分配函数 */
+static void *hooks_malloc(size_t size, void *) { return global_malloc(size); }
+
+static void hooks_free(void *ptr, void *) { global_free(ptr); }
+
+cJSON_Context *cJSON_CreateContext(const cJSON_Allocator *allocator, const cJSON_Limits *limits) {
+    cJSON_Allocator hooks = {hooks_malloc, hooks_free, NULL};
+    cJSON_Context *ctx;
+    if (!allocator) allocator = &hooks;
+    if (!allocator->malloc_fn || !allocator->free_fn) return NULL;
+    if (!(ctx = (cJSON_Context *) allocator->malloc_fn(sizeof(cJSON_Context), allocator->userdata))) return NULL;
+    memset(ctx, 0, sizeof(cJSON_Context));
+    ctx->allocator = *allocator;
+    if (limits) ctx->limits = *limits;
+    else ctx->limits.max_depth = CJSON_NESTING_LIMIT;
+    return ctx;
+}
+
+void cJSON_DeleteContext(cJSON_Context *ctx) {
+    if (!ctx) return;
+    if (thread_context == ctx) thread_context = NULL;
+    ctx->allocator.free_fn(ctx, ctx->allocator.userdata);
+}
+
+const cJSON_Error *cJSON_GetContextError(const cJSON_Context *ctx) {
+    return ctx ? &ctx->error : NULL;
+}
+
+cJSON_Context *cJSON_SetThreadContext(cJSON_Context *ctx) {
+    cJSON_Context *previous = thread_context;
+    thread_context = ctx;
+    return previous;
+}
+
+/* *_Ctx 函数的作用域：调用期间把 ctx 设为当前线程的上下文，返回时恢复 */
+struct context_scope {
+    cJSON_Context *saved;
+
+    explicit context_scope(cJSON_Context *ctx) : saved(thread_context) { thread_context = ctx; }
+
+    ~context_scope() { thread_context = saved; }
+};
+
+/*
+ * 节点池
+ * 每个线程一个，默认关闭。释放的节点挂到空闲链表上（链表指针直接存放在被回收的节点里）；
+ * 释放的短字符串按 strlen + 1 的精确大小分别压进指针栈，只用来满足同样大小的分配。
+ * 任何 C 字符串所在的缓冲区都至少有 strlen + 1 字节，所以即使调用者把 valuestring/string
+ * 换成自己 malloc 的缓冲区或就地截短，回收的块也不会小于之后从这个栈取它的请求。
+ * 设置了线程上下文时不经过节点池，内存直接交给上下文的分配器。
+ */
+#ifndef CJSON_POOL_STRING_MAX
+#define CJSON_POOL_STRING_MAX 256   // 节点池回收的最长字符串（含 \0）
+#endif
+
+typedef struct pool_block {
+    struct pool_block *next;
+} pool_block;
+
+/* 同一大小的空闲字符串，块本身不存放链表指针，不足指针大小的块也能回收 */
+typedef struct {
+    void **blocks;
+    size_t count, capacity;
+} pool_stack;
+
+typedef struct {
+    cJSON_bool enabled;
+    size_t cap;                 // 最多缓存的字节数（不含指针栈本身）
+    size_t cached;              // 当前缓存的字节数
+    size_t hits, misses;
+    pool_block *nodes;          // 空闲节点
+    pool_stack strings[CJSON_POOL_STRING_MAX + 1];  // 下标是字符串的大小（含 \0）
+} node_pool;
+
+static thread_local node_pool pool;
+
+static cJSON *pool_take_node() {
+    pool_block *block;
+    if (!pool.enabled || thread_context) return (cJSON *) cJSON_malloc(sizeof(cJSON));
+    if (!(block = pool.nodes)) {
+        pool.misses++;
+        return (cJSON *) cJSON_malloc(sizeof(cJSON));
+    }
+    pool.nodes = block->next;
+    pool.cached -= sizeof(cJSON);
+    pool.hits++;
+    return (cJSON *) block;
+}
+
+static void pool_give_node(cJSON *node) {
+    pool_block *block = (pool_block *) node;
+    if (!pool.enabled || thread_context || pool.cached + sizeof(cJSON) > pool.cap) {
+        cJSON_free(node);
+        return;
+    }
+    block->next = pool.nodes;
+    pool.nodes = block;
+    pool.cached += sizeof(cJSON);
+}
+
+/* 为节点的字符串分配 size 字节，短字符串优先从节点池中同样大小的栈取 */
+static char *string_alloc(size_t size) {
+    pool_stack *stack;
+    if (size > CJSON_POOL_STRING_MAX || !pool.enabled || thread_context) return (char *) cJSON_malloc(size);
+    stack = &pool.strings[size];
+    if (!stack->count) {
+        pool.misses++;
+        return (char *) cJSON_malloc(size);
+    }
+    pool.cached -= size;
+    pool.hits++;
+    return (char *) stack->blocks[--stack->count];
+}
+
+/*
+ * 释放节点的字符串：只有带 cJSON_StringIsPooled 标记（确定来自 cJSON_malloc）的字符串才回收到节点池，
+ * 按 strlen + 1 归入的栈不会超过缓冲区的实际容量。指针栈扩容失败时直接释放
+ */
+static void string_free(const cJSON *item, char *str) {
+    pool_stack *stack;
+    void **blocks;
+    size_t size;
+    if (!(item->type & cJSON_StringIsPooled) || !pool.enabled || thread_context ||
+        (size = strlen(str) + 1) > CJSON_POOL_STRING_MAX || pool.cached + size > pool.cap) {
+        cJSON_free(str);
         return;
     }
+    stack = &pool.strings[size];
+    if (stack->count == stack->capacity) {
+        if (!(blocks = (void **) global_malloc((stack->capacity ? stack->capacity * 2 : 16) * sizeof(void *)))) {
+            cJSON_free(str);
+            return;
+        }
+        if (stack->blocks) {
+            memcpy(blocks, stack->blocks, stack->count * sizeof(void *));
+            global_free(stack->blocks);
+        }
+        stack->blocks = blocks;
+        stack->capacity = stack->capacity ? stack->capacity * 2 : 16;
+    }
+    stack->blocks[stack->count++] = str;
+    pool.cached += size;
+}
+
+/* 线程退出时归还本线程节点池缓存的内存 */
+struct pool_reaper {
+    ~pool_reaper() { cJSON_DisableNodePool(); }
+};
+
+static thread_local pool_reaper reaper;
+
+void cJSON_EnableNodePool(size_t max_bytes) {
+    (void) &reaper;             // 首次访问时登记线程退出时的清理
+    pool.enabled = 1;
+    pool.cap = max_bytes;
+    cJSON_TrimNodePool(max_bytes);
+}
+
+void cJSON_TrimNodePool(size_t keep_bytes) {
+    pool_block *block;
+    pool_stack *stack;
+    for (size_t size = CJSON_POOL_STRING_MAX; size > 0 && pool.cached > keep_bytes; size--) {
+        stack = &pool.strings[size];
+        while (pool.cached > keep_bytes && stack->count) {
+            global_free(stack->blocks[--stack->count]);
+            pool.cached -= size;
+        }
+    }
+    while (pool.cached > keep_bytes && (block = pool.nodes)) {
+        pool.nodes = block->next;
+        pool.cached -= sizeof(cJSON);
+        global_free(block);
+    }
+}
+
+void cJSON_DisableNodePool(void) {
+    cJSON_TrimNodePool(0);
+    for (size_t size = 0; size <= CJSON_POOL_STRING_MAX; size++) {
+        if (pool.strings[size].blocks) global_free(pool.strings[size].blocks);
+        pool.strings[size].blocks = NULL;
+        pool.strings[size].capacity = 0;
+    }
+    pool.enabled = 0;
+}
+
+void cJSON_GetNodePoolStats(cJSON_NodePoolStats *stats) {
+    if (!stats) return;
+    stats->hits = pool.hits;
+    stats->misses = pool.misses;
+    stats->cached_bytes = pool.cached;
+}
 
-    cJSON_malloc = (hooks->malloc_fn) ? hooks->malloc_fn : malloc;
-    cJSON_free = (hooks->free_fn) ? hooks->free_fn : free;
+/* ASCII 大小写折叠，与区域设置无关，比 tolower 少一次函数调用 */
+static inline unsigned char ascii_lower(unsigned char c) {
+    return (unsigned char) ((unsigned) (c - 'A') < 26u ? c | 0x20 : c);
 }
 
-/* 比较两个字符串的大小（不区分大小写） */
+/* 比较两个字符串的大小（不区分 ASCII 大小写） */
 static int cJSON_strcasecmp(const char *s1, const char *s2) {
+    const unsigned char *a = (const unsigned char *) s1, *b = (const unsigned char *) s2;
     if (!s1) return (s1 == s2) ? 0 : 1;
     if (!s2) return 1;
-    for (; tolower(*s1) == tolower(*s2); ++s1, ++s2) if (*s1 == 0) return 0;
-    return tolower(*(const unsigned char *) s1) - tolower(*(const unsigned char *) s2);
+    for (; ascii_lower(*a) == ascii_lower(*b); ++a, ++b) if (*a == 0) return 0;
+    return ascii_lower(*a) - ascii_lower(*b);
+}
+
+/* 键的 FNV-1a 哈希（按 ASCII 小写折叠），从不返回 0，节点的 keyhash 以 0 表示尚未计算 */
+static unsigned key_hash(const char *key) {
+    unsigned h = 2166136261u;
+    for (const unsigned char *s = (const unsigned char *) key; *s; s++) h = (h ^ ascii_lower(*s)) * 16777619u;
+    return h ? h : 1;
 }
 
 /* 拷贝字符串，重新分配内存 */
@@ -43,69 +291,739 @@ static char *cJSON_strdup(const char *str) {
     char *copy;
 
     len = strlen(str) + 1;
-    if (!(copy = (char *) cJSON_malloc(len))) return nullptr;
+    if (!(copy = string_alloc(len))) return nullptr;
     memcpy(copy, str, len);
     return copy;
 }
 
 /* 创建一个新的 cJSON 对象并分配内存 */
 static cJSON *cJSON_New_Item() {
-    cJSON *node = (cJSON *) cJSON_malloc(sizeof(cJSON));
+    cJSON *node = pool_take_node();
     if (node) memset(node, 0, sizeof(cJSON));
     return node;
 }
 
-/* 释放 cJSON 对象 */
+/* arena 内存块，数据紧跟在结构体之后 */
+typedef struct cJSON_ArenaBlock {
+    struct cJSON_ArenaBlock *next;
+    size_t size;            // 可用字节数
+    size_t used;            // 已使用字节数
+} cJSON_ArenaBlock;
+
+struct cJSON_Arena {
+    cJSON_ArenaBlock *head;     // 第一个内存块
+    cJSON_ArenaBlock *current;  // 当前分配所在的内存块
+    size_t block_size;          // 新内存块的默认大小
+};
+
+#define CJSON_ARENA_DEFAULT_BLOCK (64 * 1024)
+#define CJSON_ARENA_ALIGN(n) (((n) + 7) & ~(size_t) 7)
+
+cJSON_Arena *cJSON_CreateArena(size_t block_size) {
+    cJSON_Arena *arena = (cJSON_Arena *) cJSON_malloc(sizeof(cJSON_Arena));
+    if (!arena) return NULL;
+    arena->head = arena->current = NULL;
+    arena->block_size = block_size ? CJSON_ARENA_ALIGN(block_size) : CJSON_ARENA_DEFAULT_BLOCK;
+    return arena;
+}
+
+/* 从 arena 中分配 size 字节（8 字节对齐），当前块不够时依次复用后续块，都不够才申请新块 */
+static void *arena_alloc(cJSON_Arena *arena, size_t size) {
+    cJSON_ArenaBlock *block = arena->current;
+    void *ptr;
+    size = CJSON_ARENA_ALIGN(size);
+    while (block && block->size - block->used < size) block = block->next;
+    if (!block) {
+        size_t blocksize = size > arena->block_size ? size : arena->block_size;
+        block = (cJSON_ArenaBlock *) cJSON_malloc(CJSON_ARENA_ALIGN(sizeof(cJSON_ArenaBlock)) + blocksize);
+        if (!block) return NULL;
+        block->next = NULL;
+        block->size = blocksize;
+        block->used = 0;
+        if (arena->current) {       // 挂到链表末尾
+            cJSON_ArenaBlock *tail = arena->current;
+            while (tail->next) tail = tail->next;
+            tail->next = block;
+        } else {
+            arena->head = block;
+        }
+    }
+    arena->current = block;
+    ptr = (char *) block + CJSON_ARENA_ALIGN(sizeof(cJSON_ArenaBlock)) + block->used;
+    block->used += size;
+    return ptr;
+}
+
+void cJSON_ResetArena(cJSON_Arena *arena) {
+    cJSON_ArenaBlock *block;
+    if (!arena) return;
+    for (block = arena->head; block; block = block->next) block->used = 0;
+    arena->current = arena->head;
+}
+
+void cJSON_DeleteArena(cJSON_Arena *arena) {
+    cJSON_ArenaBlock *block, *next;
+    if (!arena) return;
+    for (block = arena->head; block; block = next) {
+        next = block->next;
+        cJSON_free(block);
+    }
+    cJSON_free(arena);
+}
+
+/* 解析状态 */
+typedef struct {
+    cJSON_Arena *arena;     // 非空时节点和字符串从 arena 中分配
+    cJSON_bool insitu;      // 为真时字符串就地反转义，直接指向输入缓冲区
+    const char *end;        // 输入末尾，所有扫描都不会越过它
+    cJSON_bool borrow;      // 为真时（SAX）不含转义的字符串直接引用输入，含转义的反转义到 scratch 中
+    char *scratch;          // 可复用的反转义缓冲区
+    size_t scratch_size;
+    size_t max_depth;       // 嵌套层数的上限，0 表示不限制
+    int error;              // 非语法错误的错误码（内存不足、超过限制），语法错误时为 0
+    cJSON_bool keep_number_text;    // 为真时数字保留原文，用到时才转换
+} parsestate;
+
+/* 读取 p 处的字节，到达输入末尾时返回 \0 */
+static inline char peek(const char *p, const parsestate *s) {
+    return p < s->end ? *p : '\0';
+}
+
+/* 按解析状态分配内存；SAX 模式下返回复用的 scratch，只在不够大时重新分配 */
+static void *parse_alloc(parsestate *s, size_t size) {
+    size_t newsize;
+    void *ptr;
+    if (!s->borrow) {
+        if (!(ptr = s->arena ? arena_alloc(s->arena, size) : string_alloc(size))) s->error = cJSON_ErrorMemory;
+        return ptr;
+    }
+    if (size > s->scratch_size) {
+        for (newsize = s->scratch_size ? s->scratch_size : 256; newsize < size; newsize *= 2);
+        cJSON_free(s->scratch);
+        s->scratch_size = 0;
+        if (!(s->scratch = (char *) cJSON_malloc(newsize))) {
+            s->error = cJSON_ErrorMemory;
+            return NULL;
+        }
+        s->scratch_size = newsize;
+    }
+    return s->scratch;
+}
+
+/* 按解析状态创建一个新的 cJSON 对象，arena 中的节点带 cJSON_IsArena 标记，就地解析的节点带 cJSON_IsInSitu 标记 */
+static cJSON *parse_new_item(parsestate *s) {
+    cJSON *node;
+    if (!s->arena) {
+        node = cJSON_New_Item();
+        if (node) node->type = s->insitu ? cJSON_IsInSitu | cJSON_StringIsConst : cJSON_StringIsPooled;
+    } else if ((node = (cJSON *) arena_alloc(s->arena, sizeof(cJSON)))) {
+        memset(node, 0, sizeof(cJSON));
+        node->type = cJSON_IsArena | cJSON_StringIsConst;
+    }
+    if (!node) s->error = cJSON_ErrorMemory;
+    return node;
+}
+
+/*
+ * 释放 cJSON 对象及其后的兄弟节点，arena 中的节点及其字符串、指向输入缓冲区的字符串不单独释放。
+ * 把 child 看作左子树、next 看作右子树：有子节点时向右旋转，把子链表转到当前位置之前，
+ * 因此不递归也不需要额外的栈，任意深度的树都只用常数栈空间。
+ */
 void cJSON_Delete(cJSON *c) {
     cJSON *next;
     while (c) {
+        if (!(c->type & cJSON_IsReference) && c->child) {
+            next = c->child;
+            c->child = next->next;
+            next->next = c;
+            c = next;
+            continue;
+        }
         next = c->next;
-        if (!(c->type & cJSON_IsReference) && c->child) cJSON_Delete(c->child);
-        if (!(c->type & cJSON_IsReference) && c->valuestring) cJSON_free(c->valuestring);
-        if (!(c->type & cJSON_StringIsConst) && c->string) cJSON_free(c->string);
-        cJSON_free(c);
+        if (!(c->type & (cJSON_IsReference | cJSON_IsArena | cJSON_IsInSitu)) && c->valuestring)
+            string_free(c, c->valuestring);
+        if (!(c->type & cJSON_StringIsConst) && c->string) string_free(c, c->string);
+        if (c->index) cJSON_free(c->index);
+        if (!(c->type & cJSON_IsArena)) pool_give_node(c);
         c = next;
     }
 }
 
+/*
+ * SIMD 扫描
+ * 按 16/32 字节对齐的块读取输入：对齐读取不会跨越内存页，因此只要块的起始地址在输入末尾之前，
+ * 即使读到末尾之后的字节也不会访问非法内存，只需在结果中忽略起始位置之前和末尾之后的字节。
+ * 扫描到 end 仍未命中时返回 end。运行时检测 AVX2，不支持时使用 SSE2，非 x86 平台退化为逐字节扫描。
+ */
+#ifdef CJSON_SIMD_X86
+#if defined(__clang__) || defined(__SANITIZE_ADDRESS__)
+#define CJSON_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define CJSON_NO_SANITIZE
+#endif
+
+/* 空白字符的判断与 skip() 一致：1..32 之间的字节，\0 不是空白 */
+CJSON_NO_SANITIZE static const char *skip_whitespace_sse2(const char *in, const char *end) {
+    const __m128i space = _mm_set1_epi8(32), zero = _mm_setzero_si128();
+    const char *block = (const char *) ((uintptr_t) in & ~(uintptr_t) 15);
+    unsigned mask;
+    while (block < end) {
+        __m128i v = _mm_load_si128((const __m128i *) block);
+        __m128i ws = _mm_cmpeq_epi8(_mm_max_epu8(v, space), space);     // v <= 32
+        ws = _mm_andnot_si128(_mm_cmpeq_epi8(v, zero), ws);              // 且 v != 0
+        mask = ~(unsigned) _mm_movemask_epi8(ws) & 0xFFFF;              // 非空白字节
+        if (block < in) mask &= ~0u << (in - block);
+        if (mask) {
+            block += __builtin_ctz(mask);
+            return block < end ? block : end;   // 命中位置在末尾之后等同于未命中
+        }
+        block += 16;
+    }
+    return end;
+}
+
+__attribute__((target("avx2"))) CJSON_NO_SANITIZE static const char *skip_whitespace_avx2(const char *in,
+                                                                                        const char *end) {
+    const __m256i space = _mm256_set1_epi8(32), zero = _mm256_setzero_si256();
+    const char *block = (const char *) ((uintptr_t) in & ~(uintptr_t) 31);
+    unsigned mask;
+    while (block < end) {
+        __m256i v = _mm256_load_si256((const __m256i *) block);
+        __m256i ws = _mm256_cmpeq_epi8(_mm256_max_epu8(v, space), space);
+        ws = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, zero), ws);
+        mask = ~(unsigned) _mm256_movemask_epi8(ws);
+        if (block < in) mask &= ~0u << (in - block);
+        if (mask) {
+            block += __builtin_ctz(mask);
+            return block < end ? block : end;
+        }
+        block += 32;
+    }
+    return end;
+}
+
+/* 查找字符串中第一个需要特殊处理的字节：引号、反斜杠或 \0 */
+CJSON_NO_SANITIZE static const char *scan_string_sse2(const char *in, const char *end) {
+    const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\'), zero = _mm_setzero_si128();
+    const char *block = (const char *) ((uintptr_t) in & ~(uintptr_t) 15);
+    unsigned mask;
+    while (block < end) {
+        __m128i v = _mm_load_si128((const __m128i *) block);
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                   _mm_cmpeq_epi8(v, zero));
+        mask = (unsigned) _mm_movemask_epi8(hit);
+        if (block < in) mask &= ~0u << (in - block);
+        if (mask) {
+            block += __builtin_ctz(mask);
+            return block < end ? block : end;
+        }
+        block += 16;
+    }
+    return end;
+}
+
+__attribute__((target("avx2"))) CJSON_NO_SANITIZE static const char *scan_string_avx2(const char *in,
+                                                                                    const char *end) {
+    const __m256i quote = _mm256_set1_epi8('\"'), backslash = _mm256_set1_epi8('\\');
+    const __m256i zero = _mm256_setzero_si256();
+    const char *block = (const char *) ((uintptr_t) in & ~(uintptr_t) 31);
+    unsigned mask;
+    while (block < end) {
+        __m256i v = _mm256_load_si256((const __m256i *) block);
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                      _mm256_cmpeq_epi8(v, zero));
+        mask = (unsigned) _mm256_movemask_epi8(hit);
+        if (block < in) mask &= ~0u << (in - block);
+        if (mask) {
+            block += __builtin_ctz(mask);
+            return block < end ? block : end;
+        }
+        block += 32;
+    }
+    return end;
+}
+
+/* 查找字符串中第一个不是普通 ASCII 字符的字节：引号、反斜杠、控制字符或 >= 0x80 的字节（有符号比较小于 0x20） */
+CJSON_NO_SANITIZE static const char *scan_plain_sse2(const char *in, const char *end) {
+    const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\'), space = _mm_set1_epi8(0x20);
+    const char *block = (const char *) ((uintptr_t) in & ~(uintptr_t) 15);
+    unsigned mask;
+    while (block < end) {
+        __m128i v = _mm_load_si128((const __m128i *) block);
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                   _mm_cmplt_epi8(v, space));
+        mask = (unsigned) _mm_movemask_epi8(hit);
+        if (block < in) mask &= ~0u << (in - block);
+        if (mask) {
+            block += __builtin_ctz(mask);
+            return block < end ? block : end;
+        }
+        block += 16;
+    }
+    return end;
+}
+
+__attribute__((target("avx2"))) CJSON_NO_SANITIZE static const char *scan_plain_avx2(const char *in,
+                                                                                   const char *end) {
+    const __m256i quote = _mm256_set1_epi8('\"'), backslash = _mm256_set1_epi8('\\');
+    const __m256i space = _mm256_set1_epi8(0x20);
+    const char *block = (const char *) ((uintptr_t) in & ~(uintptr_t) 31);
+    unsigned mask;
+    while (block < end) {
+        __m256i v = _mm256_load_si256((const __m256i *) block);
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                      _mm256_cmpgt_epi8(space, v));     // AVX2 没有 cmplt：0x20 > v
+        mask = (unsigned) _mm256_movemask_epi8(hit);
+        if (block < in) mask &= ~0u << (in - block);
+        if (mask) {
+            block += __builtin_ctz(mask);
+            return block < end ? block : end;
+        }
+        block += 32;
+    }
+    return end;
+}
+
+/*
+ * 16 字节块中引号、反斜杠和括号的位置掩码，只保留 [begin, end) 内的字节。
+ * '[' 与 '{'、']' 与 '}' 只差 0x20 位，或上 0x20 后各用一次比较。
+ */
+CJSON_NO_SANITIZE static inline unsigned structural_mask(const char *block, const char *begin, const char *end) {
+    const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\');
+    const __m128i open = _mm_set1_epi8('{'), close = _mm_set1_epi8('}'), fold = _mm_set1_epi8(0x20);
+    __m128i v = _mm_load_si128((const __m128i *) block), f = _mm_or_si128(v, fold);
+    __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(f, open), _mm_cmpeq_epi8(f, close)),
+                               _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+    unsigned mask = (unsigned) _mm_movemask_epi8(hit);
+    if (block < begin) mask &= ~0u << (begin - block);
+    if (end - block < 16) mask &= (1u << (end - block)) - 1;
+    return mask;
+}
+
+static int cpu_has_avx2(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static const char *(*const skip_whitespace)(const char *, const char *) =
+        cpu_has_avx2() ? skip_whitespace_avx2 : skip_whitespace_sse2;
+static const char *(*const scan_string)(const char *, const char *) =
+        cpu_has_avx2() ? scan_string_avx2 : scan_string_sse2;
+static const char *(*const scan_plain)(const char *, const char *) =
+        cpu_has_avx2() ? scan_plain_avx2 : scan_plain_sse2;
+#else
+static const char *skip_whitespace(const char *in, const char *end) {
+    while (in < end && *in && (unsigned char) *in <= 32) in++;
+    return in;
+}
+
+static const char *scan_string(const char *in, const char *end) {
+    while (in < end && *in && *in != '\"' && *in != '\\') in++;
+    return in;
+}
+
+static const char *scan_plain(const char *in, const char *end) {
+    while (in < end && (unsigned char) *in >= 0x20 && (unsigned char) *in < 0x80 && *in != '\"' && *in != '\\') in++;
+    return in;
+}
+
+static unsigned structural_mask(const char *block, const char *begin, const char *end) {
+    unsigned mask = 0;
+    const char *p;
+    for (p = block < begin ? begin : block; p < end && p < block + 16; p++)
+        if (*p == '\"' || *p == '\\' || (*p | 0x20) == '{' || (*p | 0x20) == '}') mask |= 1u << (p - block);
+    return mask;
+}
+#endif
+
+/* 可被 double 精确表示的 10 的整数次幂 */
+static const double exact_powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define CJSON_MAX_EXACT_MANTISSA (1ULL << 53)
+
+#ifdef __SIZEOF_INT128__
+/*
+ * Eisel-Lemire 算法
+ * 用 5^q 的 128 位近似值乘以规格化后的尾数，绝大多数情况下即可确定正确舍入的结果，无法确定时交给兜底路径。
+ * 近似值表（q ∈ [-342, 308]）首次使用时用定长大整数精确生成：正指数取 5^q 的最高 128 位；
+ * 负指数取 floor(2^b / 5^-q) + 1 的最高 128 位，其中 floor(2^N / 5^k) 由 2^N 反复整除 5 得到。
+ */
+typedef unsigned __int128 cjson_uint128;
+
+#define CJSON_POW5_MIN (-342)
+#define CJSON_POW5_MAX 308
+#define CJSON_BIGNUM_LIMBS 28           // 1792 位，足以容纳 2^1718
+#define CJSON_BIGNUM_BITS (CJSON_BIGNUM_LIMBS * 64)
+
+static void bignum_mul_small(unsigned long long *x, unsigned m) {
+    cjson_uint128 carry = 0;
+    for (int i = 0; i < CJSON_BIGNUM_LIMBS; i++) {
+        carry += (cjson_uint128) x[i] * m;
+        x[i] = (unsigned long long) carry;
+        carry >>= 64;
+    }
+}
+
+static void bignum_div_small(unsigned long long *x, unsigned d) {
+    cjson_uint128 rem = 0;
+    for (int i = CJSON_BIGNUM_LIMBS - 1; i >= 0; i--) {
+        rem = (rem << 64) | x[i];
+        x[i] = (unsigned long long) (rem / d);
+        rem %= d;
+    }
+}
+
+static int bignum_bitlen(const unsigned long long *x) {
+    for (int i = CJSON_BIGNUM_LIMBS - 1; i >= 0; i--)
+        if (x[i]) return i * 64 + 64 - __builtin_clzll(x[i]);
+    return 0;
+}
+
+/* 返回 x >> shift 的低 128 位 */
+static cjson_uint128 bignum_shr128(const unsigned long long *x, int shift) {
+    cjson_uint128 r = 0;
+    int limb = shift / 64, bits = shift % 64;
+    for (int i = 2; i >= 0; i--) {      // 需要 x 中从 shift 开始的 192 位
+        unsigned long long v = (limb + i < CJSON_BIGNUM_LIMBS) ? x[limb + i] : 0;
+        if (i == 2) r = bits ? (cjson_uint128) v << (128 - bits) : 0;
+        else r |= bits ? (cjson_uint128) v << (64 * i) >> bits : (cjson_uint128) v << (64 * i);
+    }
+    return r;
+}
+
+/* 把 x 右移 shift 位后加 1 的结果截断到最高 128 位 */
+static cjson_uint128 bignum_top128_plus_one(const unsigned long long *x, int shift) {
+    unsigned long long y[CJSON_BIGNUM_LIMBS] = {0};
+    int limb = shift / 64, bits = shift % 64, len;
+    for (int i = 0; i + limb < CJSON_BIGNUM_LIMBS; i++) {
+        y[i] = x[i + limb] >> bits;
+        if (bits && i + limb + 1 < CJSON_BIGNUM_LIMBS) y[i] |= x[i + limb + 1] << (64 - bits);
+    }
+    for (int i = 0; i < CJSON_BIGNUM_LIMBS && ++y[i] == 0; i++) {}
+    len = bignum_bitlen(y);
+    return len > 128 ? bignum_shr128(y, len - 128) : bignum_shr128(y, 0);
+}
+
+static const cjson_uint128 *build_pow5_table(void) {
+    static cjson_uint128 table[CJSON_POW5_MAX - CJSON_POW5_MIN + 1];
+    unsigned long long pow5[CJSON_BIGNUM_LIMBS] = {1}, inverse[CJSON_BIGNUM_LIMBS] = {0};
+    const int n = CJSON_BIGNUM_BITS - 1;
+    int q, len;
+
+    for (q = 0; q <= CJSON_POW5_MAX; q++) {     // 正指数：5^q 的最高 128 位
+        len = bignum_bitlen(pow5);
+        table[q - CJSON_POW5_MIN] = len > 128 ? bignum_shr128(pow5, len - 128) : bignum_shr128(pow5, 0) << (128 - len);
+        bignum_mul_small(pow5, 5);
+    }
+
+    memset(pow5, 0, sizeof(pow5));
+    pow5[0] = 1;
+    inverse[CJSON_BIGNUM_LIMBS - 1] = 1ULL << 63;     // 2^n
+    for (q = 1; q <= -CJSON_POW5_MIN; q++) {    // 负指数：floor(2^b / 5^q) + 1 的最高 128 位
+        int z, b;
+        bignum_mul_small(pow5, 5);
+        bignum_div_small(inverse, 5);
+        z = bignum_bitlen(pow5);
+        b = q <= 27 ? z + 127 : 2 * z + 128;
+        table[-q - CJSON_POW5_MIN] = bignum_top128_plus_one(inverse, n - b);
+    }
+    return table;
+}
+
+/* 成功时返回 1 并写入 *out，无法确定正确舍入时返回 0 */
+static int eisel_lemire(unsigned long long w, int q, double *out) {
+    static const cjson_uint128 *const pow5_table = build_pow5_table();
+    cjson_uint128 power, product;
+    unsigned long long high, low, mantissa, bits;
+    int lz, upperbit, power2;
+
+    if (q < CJSON_POW5_MIN) {
+        *out = 0;
+        return 1;
+    }
+    if (q > CJSON_POW5_MAX) {
+        *out = HUGE_VAL;
+        return 1;
+    }
+
+    lz = __builtin_clzll(w);
+    w <<= lz;
+    power = pow5_table[q - CJSON_POW5_MIN];
+    product = (cjson_uint128) w * (unsigned long long) (power >> 64);
+    high = (unsigned long long) (product >> 64);
+    low = (unsigned long long) product;
+    if ((high & 0x1FF) == 0x1FF) {      // 低位可能进位，需要用上表项的低 64 位
+        unsigned long long second = (unsigned long long) (((cjson_uint128) w * (unsigned long long) power) >> 64);
+        low += second;
+        if (low < second) high++;
+    }
+    if (low == ~0ULL && (q < -27 || q > 55)) return 0;
+
+    upperbit = (int) (high >> 63);
+    mantissa = high >> (upperbit + 9);
+    power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz + 1023;
+    if (power2 <= 0) {      // 非规格化数
+        if (-power2 + 1 >= 64) {
+            *out = 0;
+            return 1;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (1ULL << 52) ? 0 : 1;
+    } else {
+        if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upperbit + 9)) == high)
+            mantissa &= ~1ULL;      // 恰好位于中点，向偶数舍入
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (2ULL << 52)) {
+            mantissa = 1ULL << 52;
+            power2++;
+        }
+        mantissa &= ~(1ULL << 52);
+        if (power2 >= 0x7FF) {
+            *out = HUGE_VAL;
+            return 1;
+        }
+    }
+    bits = mantissa | ((unsigned long long) power2 << 52);
+    memcpy(out, &bits, sizeof(bits));
+    return 1;
+}
+#endif
+
+/* 用 std::from_chars 转换数字（正确舍入且与 locale 无关），作为快速路径无法精确转换时的兜底 */
+static double parse_number_fallback(const char *num, const char *end, int exponent) {
+    double n = 0;
+    std::from_chars_result result = std::from_chars(num, end, n);
+    if (result.ec == std::errc::result_out_of_range) n = exponent > 0 ? HUGE_VAL : 0.0;   // 上溢或下溢
+    return n;
+}
+
 /**
- * @brief 解析一个数字并添加到 cJSON 对象中
+ * @brief 解析一个数字
+ *
+ * 最多 19 位有效数字时先累加成 64 位整数尾数：指数为 0 时直接转换；尾数不超过 2^53 且
+ * 10 的幂可被精确表示时用一次乘法或除法得到正确舍入的结果（Clinger 快速路径）；
+ * 其余情况使用 Eisel-Lemire 算法，超过 19 位有效数字或无法确定舍入时交给 std::from_chars。
+ * 没有小数和指数部分、且在 long long 范围内的整数同时由尾数直接得到精确的整数值（-0 除外）。
  *
- * @param item cJSON 对象，用于存储解析后的数字
  * @param num 指向数字字符串的指针
+ * @param s 解析状态，数字不会越过 s->end
+ * @param result 输出解析得到的数值
+ * @param is_int64 为 NULL 时不计算整数值，否则输出是否为可精确表示的整数
+ * @param integer 输出整数值，只在 *is_int64 为真时有效
  * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
- */static const char *parse_number(cJSON *item, const char *num) {
-    double n = 0, sign = 1, scale = 0;      // sign 正负号，scale 小数部分位数
-    int subscale = 0, signsubscale = 1;     // 科学计数法的指数部分和正负号
+ */
+static const char *parse_number_value(const char *num, parsestate *s, double *result, cJSON_bool *is_int64,
+                                      long long *integer) {
+    const char *end = s->end;
+    const char *start;                      // 不含负号的数字起始位置
+    unsigned long long mantissa = 0;        // 有效数字组成的尾数
+    int digits = 0, exponent = 0;           // 有效数字位数，十进制指数
+    int negative = 0, subscale = 0, signsubscale = 1;   // 科学计数法的指数部分和正负号
+    int integral = 1;                       // 没有小数和指数部分
+    double n;
 
     if (!num) return nullptr;                  // 无效输入
 
-    if (*num == '-') sign = -1, num++;       // 处理负号
-    while (*num == '0') num++;        // 处理 0 开头的数字
-    if (*num >= '1' && *num <= '9') {
-        do { n = (n * 10.0) + (*num++ - '0'); }
-        while (*num >= '0' && *num <= '9'); // 处理整数部分
+    if (num < end && *num == '-') negative = 1, num++;    // 处理负号
+    start = num;
+    while (num < end && *num == '0') num++;        // 处理 0 开头的数字
+    for (; num < end && *num >= '0' && *num <= '9'; num++) {  // 处理整数部分
+        if (digits++ < 19) mantissa = mantissa * 10 + (*num - '0');
+        else exponent++;
     }
-    if (*num == '.' && num[1] >= '0' && num[1] <= '9') { // 处理小数部分
+    if (end - num > 1 && *num == '.' && num[1] >= '0' && num[1] <= '9') { // 处理小数部分
         num++;
-        while (*num >= '0' && *num <= '9') {
-            n = (n * 10.0) + (*num++ - '0');
-            scale--;
-        }
+        integral = 0;
+        if (!digits) for (; num < end && *num == '0'; num++) exponent--;     // 有效数字之前的 0 只影响指数
+        for (; num < end && *num >= '0' && *num <= '9'; num++)
+            if (digits++ < 19) mantissa = mantissa * 10 + (*num - '0'), exponent--;
     }
-    if (*num == 'E' || *num == 'e') {         // 处理科学计数法
+    if (num < end && (*num == 'E' || *num == 'e')) {         // 处理科学计数法
         num++;
-        if (*num == '+') num++;
-        else if (*num == '-') signsubscale = -1, num++;
-        while (*num >= '0' && *num <= '9') subscale = (subscale * 10) + (*num++ - '0');
+        integral = 0;
+        if (num < end && *num == '+') num++;
+        else if (num < end && *num == '-') signsubscale = -1, num++;
+        for (; num < end && *num >= '0' && *num <= '9'; num++)
+            if (subscale < 100000) subscale = (subscale * 10) + (*num - '0');
+    }
+    exponent += subscale * signsubscale;
+
+    if (!mantissa) n = 0;
+    else if (digits > 19) n = parse_number_fallback(start, num, exponent);
+    else if (!exponent) n = (double) mantissa;
+#if FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 1
+    else if (mantissa <= CJSON_MAX_EXACT_MANTISSA && exponent >= -22 && exponent <= 22)
+        n = exponent < 0 ? (double) mantissa / exact_powers_of_ten[-exponent]
+                         : (double) mantissa * exact_powers_of_ten[exponent];
+    else if (mantissa <= CJSON_MAX_EXACT_MANTISSA && exponent > 22 && exponent <= 22 + 15 &&
+             mantissa <= CJSON_MAX_EXACT_MANTISSA / (unsigned long long) exact_powers_of_ten[exponent - 22])
+        n = (double) mantissa * exact_powers_of_ten[exponent - 22] * 1e22;  // 尾数补 0 后仍可精确表示
+#endif
+#ifdef __SIZEOF_INT128__
+    else if (!eisel_lemire(mantissa, exponent, &n)) n = parse_number_fallback(start, num, exponent);
+#else
+    else n = parse_number_fallback(start, num, exponent);
+#endif
+    if (negative) n = -n;
+    *result = n;
+    if (is_int64) {     // 负数的绝对值最大可到 2^63
+        *is_int64 = integral && digits <= 19 && (negative ? mantissa - 1 < 1ULL << 63 : mantissa <= (unsigned long long) LLONG_MAX);
+        if (*is_int64) *integer = negative ? (long long) (0ULL - mantissa) : (long long) mantissa;
     }
-    n = sign * n * pow(10.0, (scale + subscale * signsubscale)); // 计算最终结果
+    return num;
+}
+
+/* 把数值存入 cJSON 对象，valueint 超出 int 范围时取边界值 */
+static void set_number(cJSON *item, double n) {
     item->valuedouble = n;
-    item->valueint = (int) n;
-    item->type = cJSON_Number;
+    if (n >= INT_MAX) item->valueint = INT_MAX;
+    else if (n <= (double) INT_MIN) item->valueint = INT_MIN;
+    else item->valueint = (int) n;
+    item->type |= cJSON_Number;
+}
+
+/* 把精确的整数值存入 cJSON 对象，valuedouble 是最接近的 double */
+static void set_int64(cJSON *item, long long n) {
+    set_number(item, (double) n);
+    item->valueint64 = n;
+    item->type |= cJSON_NumberIsInt64;
+}
+
+/* 校验一个数字：-?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)? */
+static const char *validate_number(const char *p, const char *end) {
+    if (p < end && *p == '-') p++;
+    if (p < end && *p == '0') p++;
+    else if (p < end && *p >= '1' && *p <= '9') while (++p < end && *p >= '0' && *p <= '9') {}
+    else {
+        ep = p;
+        return NULL;
+    }
+    if (p < end && *p == '.') {
+        if (++p >= end || *p < '0' || *p > '9') {
+            ep = p;
+            return NULL;
+        }
+        while (++p < end && *p >= '0' && *p <= '9') {}
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        if (++p < end && (*p == '+' || *p == '-')) p++;
+        if (p >= end || *p < '0' || *p > '9') {
+            ep = p;
+            return NULL;
+        }
+        while (++p < end && *p >= '0' && *p <= '9') {}
+    }
+    return p;
+}
+
+/*
+ * 保留原文的数字（cJSON_KeepNumberText）：valuestring 是原文的副本，输出时原样写出；
+ * valuedouble 先置为 NaN 表示尚未转换，第一次调用 cJSON_GetNumberValue() 时才转换。
+ * 只有符合 JSON 语法的原文才保留，宽松接受的写法（如 "-"、"1."、"01"）仍按原来的方式转换，两种模式接受的输入相同。
+ */
+static const char *parse_number_text(cJSON *item, const char *num, parsestate *s) {
+    const char *saved = ep, *end = validate_number(num, s->end);
+    char *text;
+    ep = saved;     // 不合语法时回到普通转换，这里的出错位置无意义
+    if (!end || (end < s->end && *end >= '0' && *end <= '9')) return NULL;
+    if (!(text = (char *) parse_alloc(s, end - num + 1))) return NULL;
+    memcpy(text, num, end - num);
+    text[end - num] = 0;
+    item->valuestring = text;
+    item->valuedouble = NAN;
+    item->type |= cJSON_Number | cJSON_NumberIsRaw;
+    return end;
+}
+
+/**
+ * @brief 解析一个数字并添加到 cJSON 对象中
+ *
+ * @param item cJSON 对象，用于存储解析后的数字
+ * @param num 指向数字字符串的指针
+ * @param s 解析状态
+ * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
+ */
+static const char *parse_number(cJSON *item, const char *num, parsestate *s) {
+    const char *end;
+    double n;
+    long long integer;
+    cJSON_bool is_int64;
+    if (s->keep_number_text) {
+        if ((end = parse_number_text(item, num, s))) return end;
+        if (s->error) return NULL;  // 内存不足
+    }
+    if (!(num = parse_number_value(num, s, &n, &is_int64, &integer))) return NULL;
+    if (is_int64) set_int64(item, integer);
+    else set_number(item, n);
     return num;
 }
 
+/* 转换保留原文的数字，结果存入 valuedouble、valueint 和 valueint64，原文保留用于输出 */
+static void number_decode(cJSON *item) {
+    parsestate s = {};
+    double n;
+    long long integer;
+    cJSON_bool is_int64;
+    s.end = item->valuestring + strlen(item->valuestring);
+    parse_number_value(item->valuestring, &s, &n, &is_int64, &integer);
+    if (is_int64) set_int64(item, integer);
+    else set_number(item, n);
+}
+
+/* 节点是否保存着与 valuedouble 一致的整数值（直接修改 valuedouble 后整数值作废） */
+static cJSON_bool has_int64(const cJSON *item) {
+    return (item->type & cJSON_NumberIsInt64) && (double) item->valueint64 == item->valuedouble;
+}
+
+double cJSON_GetNumberValue(const cJSON *item) {
+    if (!item || !(item->type & cJSON_Number)) return NAN;
+    if ((item->type & cJSON_NumberIsRaw) && std::isnan(item->valuedouble)) number_decode((cJSON *) item);   // 只是补上缓存的数值
+    return item->valuedouble;
+}
+
+long long cJSON_GetInt64(const cJSON *item) {
+    double d;
+    if (!item || !(item->type & cJSON_Number)) return 0;
+    if ((item->type & cJSON_NumberIsRaw) && std::isnan(item->valuedouble)) number_decode((cJSON *) item);
+    if (has_int64(item)) return item->valueint64;
+    d = item->valuedouble;
+    if (d != d) return 0;
+    if (d >= 9223372036854775807.0) return LLONG_MAX;     // 该常量实际是 2^63
+    if (d <= -9223372036854775808.0) return LLONG_MIN;
+    return (long long) d;
+}
+
+/* 丢弃保留的原文，新值不再对应原文 */
+static void number_drop_text(cJSON *object) {
+    if (object->type & cJSON_NumberIsRaw) {
+        if (!(object->type & (cJSON_IsReference | cJSON_IsArena | cJSON_IsInSitu))) string_free(object, object->valuestring);
+        object->valuestring = NULL;
+        object->type &= ~cJSON_NumberIsRaw;
+    }
+}
+
+double cJSON_SetNumberHelper(cJSON *object, double number) {
+    number_drop_text(object);
+    object->type &= ~cJSON_NumberIsInt64;
+    object->valuedouble = number;
+    if (number >= INT_MAX) object->valueint = INT_MAX;
+    else if (number <= (double) INT_MIN) object->valueint = INT_MIN;
+    else object->valueint = (int) number;
+    return number;
+}
+
+long long cJSON_SetInt64Helper(cJSON *object, long long number) {
+    number_drop_text(object);
+    set_int64(object, number);
+    return number;
+}
+
 /* 找到 >= x 的最小的 2 的幂 */
 static size_t pow2gt(size_t x) {
     --x;
@@ -114,29 +1032,61 @@ static size_t pow2gt(size_t x) {
     x |= x >> 4;
     x |= x >> 8;
     x |= x >> 16;
+#if SIZE_MAX > 0xFFFFFFFFu
+    x |= x >> 32;
+#endif
     return x + 1;
 }
 
-/* 缓冲区结构体 */
+#define CJSON_PRINT_DEFAULT_BUFFER 256  // 输出缓冲区的初始大小
+#ifndef CJSON_WRITER_CHUNK
+#define CJSON_WRITER_CHUNK 4096         // 流式输出时栈上块的大小
+#endif
+#ifndef CJSON_FILE_CHUNK
+#define CJSON_FILE_CHUNK (64 * 1024)    // 输出到文件时块的大小
+#endif
+
+/* 输出缓冲区：各输出函数直接追加到 buffer + offset，并返回写入的字节数（0 表示失败） */
 typedef struct {
     char *buffer;    // 缓冲区内容
     size_t length;          // 缓冲区长度
-    size_t offset;          // 缓冲区偏移
+    size_t offset;          // 已写入的字节数
+    cJSON_WriteCallback write;  // 非 NULL 时为流式输出：buffer 是固定大小的块，写满后交给回调
+    void *ctx;              // 回调的用户数据
+    cJSON_bool noalloc;     // buffer 由调用者提供，空间不足时直接失败，不扩容也不释放
 } printbuffer;
 
+/* 流式输出：把块中已写入的内容交给回调并清空块 */
+static cJSON_bool print_flush(printbuffer *p) {
+    if (p->offset && !p->write(p->buffer, p->offset, p->ctx)) return 0;
+    p->offset = 0;
+    return 1;
+}
+
 /**
- * @brief 检查缓冲区是否足够，不够则重新分配内存
+ * @brief 确保缓冲区在当前偏移之后还有 needed 字节可写，不够则按 2 的幂扩容
+ *
+ * 返回的指针只在下一次 ensure 之前有效。扩容失败时释放缓冲区。
+ * 流式输出时改为先把块交给回调，needed 不能超过块大小；调用者提供的缓冲区不扩容。
  *
  * @param p 指向 printbuffer 的指针
  * @param needed 需要的额外空间大小
- * @return char* 成功时返回新的缓冲区指针，失败时返回 NULL
- */static char *ensure(printbuffer *p, size_t needed) {
+ * @return char* 成功时返回 buffer + offset，失败时返回 NULL
+ */
+static char *ensure(printbuffer *p, size_t needed) {
     char *newbuffer;
     size_t newsize;
     if (!p || !p->buffer) return nullptr;
     needed += p->offset;        // 计算新的长度
     if (needed <= p->length) return p->buffer + p->offset; // 如果长度足够，直接返回
 
+    if (p->write) {
+        needed -= p->offset;
+        if (needed > p->length || !print_flush(p)) return NULL;
+        return p->buffer;
+    }
+    if (p->noalloc) return NULL;
+
     newsize = pow2gt(needed);   // 找到 >= needed 的最小的 2 的幂
     newbuffer = (char *) cJSON_malloc(newsize); // 重新分配内存
     if (!newbuffer) {
@@ -144,95 +1094,401 @@ typedef struct {
         p->length = 0, p->buffer = 0;
         return NULL;
     }
-    memcpy(newbuffer, p->buffer, p->length); // 拷贝原来的内容
+    memcpy(newbuffer, p->buffer, p->offset); // 只拷贝已写入的内容
     cJSON_free(p->buffer); // 释放原来的内存
     p->length = newsize;    // 更新长度
     p->buffer = newbuffer;  // 更新内容
     return p->buffer + p->offset; // 返回新的偏移
 }
 
-/**
- * @brief 更新缓冲区的偏移
- *
- * @param p 指向 printbuffer 的指针
- * @return size_t 返回更新后的偏移量
- */static size_t update_offset(printbuffer *p) {
-    if (!p || !p->buffer) return 0;
-    p->offset += strlen(p->buffer + p->offset); // 更新偏移
-    return p->offset;
+/* 向缓冲区追加 len 字节，返回写入的字节数，失败返回 0 */
+static size_t print_raw(printbuffer *p, const char *data, size_t len) {
+    char *out;
+    if (p->write && len > p->length - p->offset) {  // 流式输出且放不下：先清空块，超过块大小的数据直接交给回调
+        if (!print_flush(p)) return 0;
+        if (len >= p->length) return p->write(data, len, p->ctx) ? len : 0;
+    }
+    if (!(out = ensure(p, len))) return 0;
+    memcpy(out, data, len);
+    p->offset += len;
+    return len;
 }
 
-/* 输出一个 cJSON 对象的数字部分到缓冲区 */
-static char *print_number(cJSON *item, printbuffer *p) {
-    char *str = NULL;
-    double d = item->valuedouble;
-    if (d == 0) {
-        if (p) str = ensure(p, 2);
-        else str = (char *) cJSON_malloc(2);
-        if (str) strcpy(str, "0");
-    } else if (fabs(((double) item->valueint) - d) <= DBL_EPSILON && d <= INT_MAX && d >= INT_MIN) {
-        if (p) str = ensure(p, 21);
-        else str = (char *) cJSON_malloc(21);
-        if (str) sprintf(str, "%d", item->valueint);
-    } else {
-        if (p) str = ensure(p, 64);
-        else str = (char *) cJSON_malloc(64);
-        if (str) {
-            if (fabs(floor(d) - d) <= DBL_EPSILON && fabs(d) < 1.0e60) sprintf(str, "%.0f", d);
-            else if (fabs(d) < 1.0e-6 || fabs(d) > 1.0e9) sprintf(str, "%e", d);
-            else
-                sprintf(str, "%f", d);
-        }
+/* 向缓冲区追加 depth 个制表符缩进，返回写入的字节数（depth 为 0 时返回 0） */
+static size_t print_indent(printbuffer *p, int depth) {
+    size_t left = depth > 0 ? (size_t) depth : 0, n;
+    char *out;
+    while (left) {      // 流式输出时缩进可能长于一个块，分段写入
+        n = p->write && left > p->length ? p->length : left;
+        if (!(out = ensure(p, n))) return 0;
+        memset(out, '\t', n);
+        p->offset += n;
+        left -= n;
     }
-    return str;
+    return depth > 0 ? (size_t) depth : 0;
 }
 
-static unsigned parse_hex4(const char *str) {
-    unsigned h = 0, i;
-    for (i = 0; i < 4; i++) {
-        h <<= 4;
-        if (str[i] >= '0' && str[i] <= '9') h |= str[i] - '0';
-        else if (str[i] >= 'A' && str[i] <= 'F') h |= str[i] - ('A' - 10);
-        else if (str[i] >= 'a' && str[i] <= 'f') h |= str[i] - ('a' - 10);
-        else return 0;
+/* 两位十进制数字查找表，用于整数快速转换 */
+static const char digit_pairs[201] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+/* 将整数转换为十进制字符串（不含 \0），返回写入的字节数 */
+static int print_int64(long long value, char *out) {
+    char buffer[20];
+    char *ptr = buffer + sizeof(buffer);
+    unsigned long long u = value < 0 ? 0ULL - (unsigned long long) value : (unsigned long long) value;
+    int len;
+
+    while (u >= 100) {
+        unsigned idx = (unsigned) (u % 100) * 2;
+        u /= 100;
+        *--ptr = digit_pairs[idx + 1];
+        *--ptr = digit_pairs[idx];
     }
-    return h;
+    if (u >= 10) {
+        *--ptr = digit_pairs[u * 2 + 1];
+        *--ptr = digit_pairs[u * 2];
+    } else {
+        *--ptr = (char) ('0' + u);
+    }
+    if (value < 0) *--ptr = '-';
+    len = (int) (buffer + sizeof(buffer) - ptr);
+    memcpy(out, ptr, len);
+    return len;
 }
 
-/* 解析一个字符串并添加到 cJSON 对象中 */
-static const unsigned char firstByteMark[7] = {0, 0, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};     // UTF-8 编码的第一个字节的掩码
-/**
- * @brief 解析 JSON 字符串值
- *
- * @param item cJSON 对象，用于存储解析后的字符串
- * @param str 指向 JSON 字符串的指针
- * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
+/*
+ * Grisu2 最短表示
+ * 生成能精确还原原 double 的十进制数字串（value = digits * 10^K），算法与缓存的 10 的幂表同 RapidJSON。
  */
-static const char *parse_string(cJSON *item, const char *str) {
-    const char *ptr = str + 1;
-    char *ptr2;
-    char *out;
-    int len = 0;
-    unsigned uc, uc2;
-    if (*str != '\"') {
-        ep = str;
-        return NULL;
-    } // 非法输入，不是一个字符串
-
-    while (*ptr != '\"' && *ptr && ++len) if (*ptr++ == '\\') ptr++; // 计算字符串长度
-    if (*ptr != '\"') {
-        ep = ptr;
+typedef struct {
+    unsigned long long f;   // 尾数
+    int e;                  // 二进制指数
+} diy_fp;
+
+static const unsigned long long cached_powers_f[] = {
+        0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+        0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+        0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+        0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+        0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+        0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+        0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+        0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+        0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+        0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+        0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+        0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+        0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+        0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+        0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+        0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+        0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+        0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+        0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+        0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+        0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+        0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const short cached_powers_e[] = {
+        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954,
+        -927, -901, -874, -847, -821, -794, -768, -741, -715, -688, -661,
+        -635, -608, -582, -555, -529, -502, -475, -449, -422, -396, -369,
+        -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77,
+        -50, -24, 3, 30, 56, 83, 109, 136, 162, 189, 216,
+        242, 269, 295, 322, 348, 375, 402, 428, 455, 481, 508,
+        534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800,
+        827, 853, 880, 907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const unsigned long long powers_of_ten_u64[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+        1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+        1000000000000000000ULL, 10000000000000000000ULL
+};
+
+#define CJSON_DP_HIDDEN_BIT (1ULL << 52)
+
+static diy_fp diy_fp_multiply(diy_fp a, diy_fp b) {
+    const unsigned long long M32 = 0xFFFFFFFFULL;
+    unsigned long long ah = a.f >> 32, al = a.f & M32, bh = b.f >> 32, bl = b.f & M32;
+    unsigned long long hh = ah * bh, hl = ah * bl, lh = al * bh, ll = al * bl;
+    unsigned long long tmp = (ll >> 32) + (hl & M32) + (lh & M32) + (1ULL << 31);  // 四舍五入
+    diy_fp r;
+    r.f = hh + (hl >> 32) + (lh >> 32) + (tmp >> 32);
+    r.e = a.e + b.e + 64;
+    return r;
+}
+
+static diy_fp diy_fp_normalize(diy_fp v) {
+    int s = __builtin_clzll(v.f);
+    v.f <<= s;
+    v.e -= s;
+    return v;
+}
+
+static void grisu_round(char *buffer, int len, unsigned long long delta, unsigned long long rest,
+                        unsigned long long ten_kappa, unsigned long long wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static int count_decimal_digit32(unsigned n) {
+    int count = 1;
+    while (n >= 10 && count < 9) n /= 10, count++;
+    return count;
+}
+
+static void grisu_digit_gen(diy_fp W, diy_fp Mp, unsigned long long delta, char *buffer, int *len, int *K) {
+    diy_fp one, wp_w;
+    unsigned p1;
+    unsigned long long p2;
+    int kappa;
+
+    one.f = 1ULL << -Mp.e;
+    one.e = Mp.e;
+    wp_w.f = Mp.f - W.f;
+    wp_w.e = Mp.e;
+    p1 = (unsigned) (Mp.f >> -one.e);
+    p2 = Mp.f & (one.f - 1);
+    kappa = count_decimal_digit32(p1);
+    *len = 0;
+
+    while (kappa > 0) {     // 整数部分
+        unsigned d = p1 / (unsigned) powers_of_ten_u64[kappa - 1];
+        p1 %= (unsigned) powers_of_ten_u64[kappa - 1];
+        if (d || *len) buffer[(*len)++] = (char) ('0' + d);
+        kappa--;
+        unsigned long long tmp = ((unsigned long long) p1 << -one.e) + p2;
+        if (tmp <= delta) {
+            *K += kappa;
+            grisu_round(buffer, *len, delta, tmp, powers_of_ten_u64[kappa] << -one.e, wp_w.f);
+            return;
+        }
+    }
+
+    for (;;) {      // 小数部分
+        p2 *= 10;
+        delta *= 10;
+        char d = (char) (p2 >> -one.e);
+        if (d || *len) buffer[(*len)++] = (char) ('0' + d);
+        p2 &= one.f - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            grisu_round(buffer, *len, delta, p2, one.f, wp_w.f * (-kappa < 20 ? powers_of_ten_u64[-kappa] : 0));
+            return;
+        }
+    }
+}
+
+/* 对正的有限 double 生成最短数字串，返回数字个数，*K 为十进制指数 */
+static int grisu2(double value, char *buffer, int *K) {
+    unsigned long long bits;
+    diy_fp v, w_m, w_p, c_mk, W, Wp, Wm;
+    int biased_e, k, len;
+    unsigned index;
+    double dk;
+
+    memcpy(&bits, &value, sizeof(bits));
+    biased_e = (int) ((bits >> 52) & 0x7FF);
+    v.f = bits & (CJSON_DP_HIDDEN_BIT - 1);
+    if (biased_e) {
+        v.f += CJSON_DP_HIDDEN_BIT;
+        v.e = biased_e - 1075;
+    } else {
+        v.e = -1074;
+    }
+
+    /* 规格化的上下边界 */
+    w_p.f = (v.f << 1) + 1;
+    w_p.e = v.e - 1;
+    while (!(w_p.f & (CJSON_DP_HIDDEN_BIT << 1))) w_p.f <<= 1, w_p.e--;
+    w_p.f <<= 64 - 52 - 2;
+    w_p.e -= 64 - 52 - 2;
+    if (v.f == CJSON_DP_HIDDEN_BIT) w_m.f = (v.f << 2) - 1, w_m.e = v.e - 2;
+    else w_m.f = (v.f << 1) - 1, w_m.e = v.e - 1;
+    w_m.f <<= w_m.e - w_p.e;
+    w_m.e = w_p.e;
+
+    /* 选取缓存的 10 的幂，使乘积的二进制指数落在 [-60, -32] */
+    dk = (-61 - w_p.e) * 0.30102999566398114 + 347;
+    k = (int) dk;
+    if (dk - k > 0.0) k++;
+    index = (unsigned) ((k >> 3) + 1);
+    *K = -(-348 + (int) (index << 3));
+    c_mk.f = cached_powers_f[index];
+    c_mk.e = cached_powers_e[index];
+
+    W = diy_fp_multiply(diy_fp_normalize(v), c_mk);
+    Wp = diy_fp_multiply(w_p, c_mk);
+    Wm = diy_fp_multiply(w_m, c_mk);
+    Wm.f++;
+    Wp.f--;
+    grisu_digit_gen(W, Wp, Wp.f - Wm.f, buffer, &len, K);
+    return len;
+}
+
+/* 把 digits * 10^K 排版成 JSON 数字：小数点位置在 (-6, 21] 内用定点表示，否则用科学计数法 */
+static int format_decimal(char *buffer, int len, int K, char *out) {
+    int kk = len + K;      // 小数点相对于第一位数字的位置
+    char *ptr = out;
+
+    if (K >= 0 && kk <= 21) {       // 整数：补 0
+        memcpy(ptr, buffer, len);
+        memset(ptr + len, '0', K);
+        ptr += kk;
+    } else if (kk > 0 && kk <= 21) {    // 小数点在中间
+        memcpy(ptr, buffer, kk);
+        ptr[kk] = '.';
+        memcpy(ptr + kk + 1, buffer + kk, len - kk);
+        ptr += len + 1;
+    } else if (kk > -6 && kk <= 0) {    // 0.000ddd
+        *ptr++ = '0';
+        *ptr++ = '.';
+        memset(ptr, '0', -kk);
+        memcpy(ptr - kk, buffer, len);
+        ptr += len - kk;
+    } else {    // d.ddde[-]xx
+        *ptr++ = buffer[0];
+        if (len > 1) {
+            *ptr++ = '.';
+            memcpy(ptr, buffer + 1, len - 1);
+            ptr += len - 1;
+        }
+        *ptr++ = 'e';
+        ptr += print_int64(kk - 1, ptr);
+    }
+    return (int) (ptr - out);
+}
+
+/* 将 double 转换为能精确还原的最短 JSON 数字（不含 \0），返回写入的字节数 */
+static int print_double(double d, char *out) {
+    char digits[24];
+    int len, K;
+
+    if (d != d || d - d != 0) {     // NaN 和无穷大在 JSON 中无法表示
+        memcpy(out, "null", 4);
+        return 4;
+    }
+    if (d == 0) {
+        if (std::signbit(d)) {
+            memcpy(out, "-0", 2);
+            return 2;
+        }
+        *out = '0';
+        return 1;
+    }
+    if (d == floor(d) && fabs(d) < 9007199254740992.0) return print_int64((long long) d, out);    // 可精确表示的整数
+
+    if (d < 0) {
+        *out = '-';
+        len = grisu2(-d, digits, &K);
+        return 1 + format_decimal(digits, len, K, out + 1);
+    }
+    len = grisu2(d, digits, &K);
+    return format_decimal(digits, len, K, out);
+}
+
+/* 输出一个 cJSON 对象的数字部分到缓冲区，返回写入的字节数 */
+static size_t print_number(const cJSON *item, printbuffer *p) {
+    char number[32];    // 最长形如 -0.0000012345678901234567 或 -1.2345678901234567e-308
+    char *out;
+    int len;
+    if ((item->type & cJSON_NumberIsRaw) && item->valuestring)  // 保留原文的数字原样写出
+        return print_raw(p, item->valuestring, strlen(item->valuestring));
+    if (p->length - p->offset < sizeof(number)) {   // 剩余空间不足 32 字节时先写到栈上，按实际长度追加
+        len = has_int64(item) ? print_int64(item->valueint64, number) : print_double(item->valuedouble, number);
+        return print_raw(p, number, (size_t) len);
+    }
+    out = p->buffer + p->offset;
+    len = has_int64(item) ? print_int64(item->valueint64, out) : print_double(item->valuedouble, out);
+    p->offset += len;
+    return (size_t) len;
+}
+
+static unsigned parse_hex4(const char *str) {
+    unsigned h = 0, i;
+    for (i = 0; i < 4; i++) {
+        h <<= 4;
+        if (str[i] >= '0' && str[i] <= '9') h |= str[i] - '0';
+        else if (str[i] >= 'A' && str[i] <= 'F') h |= str[i] - ('A' - 10);
+        else if (str[i] >= 'a' && str[i] <= 'f') h |= str[i] - ('a' - 10);
+        else return 0;
+    }
+    return h;
+}
+
+/* 解析一个字符串并添加到 cJSON 对象中 */
+static const unsigned char firstByteMark[7] = {0, 0, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};     // UTF-8 编码的第一个字节的掩码
+/**
+ * @brief 解析 JSON 字符串，得到反转义后的内容及其长度
+ *
+ * 就地解析时在输入缓冲区内反转义（结果不会比原文长），并把结束引号改写为 \0；
+ * SAX 模式下不含转义的字符串直接指向输入，不以 \0 结尾。
+ *
+ * @param str 指向 JSON 字符串的指针
+ * @param s 解析状态
+ * @param result 输出反转义后的字符串
+ * @param length 输出反转义后的长度
+ * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
+ */
+static const char *parse_string_view(const char *str, parsestate *s, char **result, size_t *length) {
+    const char *ptr = str + 1;
+    const char *end;
+    char *ptr2;
+    char *out;
+    size_t len;
+    unsigned uc, uc2;
+    if (peek(str, s) != '\"') {
+        ep = str;
+        return NULL;
+    } // 非法输入，不是一个字符串
+
+    end = scan_string(ptr, s->end);
+    if (peek(end, s) == '\"') {    // 不含转义的字符串：直接整段拷贝
+        len = end - ptr;
+        if (s->insitu) out = (char *) ptr;
+        else if (s->borrow) {
+            *result = (char *) ptr;
+            *length = len;
+            return end + 1;
+        } else {
+            out = (char *) parse_alloc(s, len + 1);
+            if (!out) return NULL;
+            memcpy(out, ptr, len);
+        }
+        out[len] = 0;
+        *result = out;
+        *length = len;
+        return end + 1;
+    }
+
+    while (peek(end, s) == '\\' && peek(end + 1, s)) end = scan_string(end + 2, s->end);  // 跳过转义字符，找到字符串的结束
+    if (peek(end, s) != '\"') {
+        ep = end;
         return NULL;
-    } // 非法输入，没有找到字符串的结束
+    } // 非法输入，没有找到字符串的结束（包括遇到 \0 或输入末尾）
 
-    out = (char *) cJSON_malloc(len + 1); // 分配内存
-    if (!out) return NULL;
+    if (s->insitu) out = (char *) ptr;  // 写指针始终落后于读指针
+    else if (!(out = (char *) parse_alloc(s, end - ptr + 1))) return NULL; // 转义后的长度不会超过原始长度
 
-    ptr = str + 1;
-    ptr2 = out; // 重新指向字符串
-    while (*ptr != '\"' && *ptr) {
-        if (*ptr != '\\') *ptr2++ = *ptr++;
-        else {
+    ptr2 = out;
+    while (ptr < end) {
+        if (*ptr != '\\') {       // 整段拷贝到下一个转义字符
+            const char *run = scan_string(ptr, end);
+            if (run > end) run = end;
+            memmove(ptr2, ptr, run - ptr);  // 就地解析时源与目标可能重叠
+            ptr2 += run - ptr;
+            ptr = run;
+        } else {
             ptr++;
             switch (*ptr) {
                 case 'b':
@@ -251,13 +1507,17 @@ static const char *parse_string(cJSON *item, const char *str) {
                     *ptr2++ = '\t';
                     break;
                 case 'u': {                // 处理 Unicode 编码
+                    if (end - ptr < 5) {    // 不足 4 位十六进制数字
+                        ptr = end - 1;
+                        break;
+                    }
                     uc = parse_hex4(ptr + 1);
                     ptr += 4;         // 解析 4 位的 Unicode 编码
 
                     if ((uc >= 0xDC00 && uc <= 0xDFFF) || uc == 0) break; // 无效的 Unicode 编码（低位代理项）
 
                     if (uc >= 0xD800 && uc <= 0xDBFF) {          // 高位代理项
-                        if (ptr[1] != '\\' || ptr[2] != 'u') break; // 缺少低位代理项
+                        if (end - ptr < 7 || ptr[1] != '\\' || ptr[2] != 'u') break; // 缺少低位代理项
                         uc2 = parse_hex4(ptr + 3);
                         ptr += 6;       // 解析低位代理项
                         if (uc2 < 0xDC00 || uc2 > 0xDFFF) break;   // 无效的 Unicode 编码（高位代理项）
@@ -274,14 +1534,18 @@ static const char *parse_string(cJSON *item, const char *str) {
                         case 4:
                             *--ptr2 = (char) ((uc | 0x80) & 0xBF);
                             uc >>= 6;
+                            [[fallthrough]];
                         case 3:
                             *--ptr2 = (char) ((uc | 0x80) & 0xBF);
                             uc >>= 6;
+                            [[fallthrough]];
                         case 2:
                             *--ptr2 = (char) ((uc | 0x80) & 0xBF);
                             uc >>= 6;
+                            [[fallthrough]];
                         case 1:
                             *--ptr2 = (char) (uc | firstByteMark[len]);
+                            [[fallthrough]];
                         default:
                             break;
                     }
@@ -296,112 +1560,130 @@ static const char *parse_string(cJSON *item, const char *str) {
         }
     }
     *ptr2 = 0;
-    if (*ptr == '\"') ptr++;
-    item->valuestring = out;
-    item->type = cJSON_String;
-    return ptr;
+    *result = out;
+    *length = ptr2 - out;
+    return end + 1;
 }
 
 /**
- * @brief 将提供的 string 渲染为可以打印的转义版本，返回新的字符串
+ * @brief 解析 JSON 字符串值并存入 cJSON 对象
  *
- * @param str 指向要打印的字符串的指针
- * @param p 指向 printbuffer 的指针，用于存储转换后的字符串
- * @return char* 成功时返回转换后的字符串，失败时返回 NULL
- */static char *print_string_ptr(const char *str, printbuffer *p) {
-    const char *ptr;
-    char *ptr2, *out;
-    size_t len = 0;
-    int flag = 0;
-    unsigned char token;
+ * @param item cJSON 对象，用于存储解析后的字符串
+ * @param str 指向 JSON 字符串的指针
+ * @param s 解析状态
+ * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
+ */
+static const char *parse_string(cJSON *item, const char *str, parsestate *s) {
+    size_t length;
+    str = parse_string_view(str, s, &item->valuestring, &length);
+    if (str) item->type |= cJSON_String;
+    return str;
+}
 
-    if (!str) {
-        if (p) out = ensure(p, 3);          // 3 个字符：左右引号和 \0
-        else out = (char *) cJSON_malloc(3);
-        if (!out) return NULL;
-        strcpy(out, "\"\"");
-        return out;
+/* 把需要转义的字符 token 写成 \X 或 \u00XX 形式，返回写入的字节数 */
+static int print_escape(unsigned char token, char *out) {
+    static const char hex[] = "0123456789abcdef";
+    out[0] = '\\';
+    switch (token) {
+        case '\\':
+            out[1] = '\\';
+            return 2;
+        case '\"':
+            out[1] = '\"';
+            return 2;
+        case '\b':
+            out[1] = 'b';
+            return 2;
+        case '\f':
+            out[1] = 'f';
+            return 2;
+        case '\n':
+            out[1] = 'n';
+            return 2;
+        case '\r':
+            out[1] = 'r';
+            return 2;
+        case '\t':
+            out[1] = 't';
+            return 2;
+        default:
+            out[1] = 'u';
+            out[2] = '0';
+            out[3] = '0';
+            out[4] = hex[token >> 4];
+            out[5] = hex[token & 15];
+            return 6;
     }
+}
 
-    for (ptr = str; *ptr; ptr++)
-        flag |= ((*ptr > 0 && *ptr < 32) || (*ptr == '\"') || (*ptr == '\\'));   // ASCII 控制字符、引号、反斜杠
-
-    if (!flag) {
-        len = ptr - str;
-
-        if (p) out = ensure(p, len + 3);
-        else out = (char *) cJSON_malloc(len + 3);
-
-        if (!out) return NULL;
-        ptr2 = out;
-        *ptr2++ = '\"';
-        strcpy(ptr2, str);
-        ptr2[len] = '\"';
-        ptr2[len + 1] = 0;
+/* 流式输出且转义后的字符串超过一个块时，按“原样片段 + 转义序列”分段写入 */
+static size_t print_string_runs(const char *str, size_t len, size_t total, printbuffer *p) {
+    const char *run = str, *ptr, *end = str + len;
+    char esc[6];
+    unsigned char token;
 
-        return out;
+    if (!print_raw(p, "\"", 1)) return 0;
+    for (ptr = str; ptr < end; ptr++) {
+        token = (unsigned char) *ptr;
+        if (token > 31 && token != '\"' && token != '\\') continue;
+        if (ptr > run && !print_raw(p, run, ptr - run)) return 0;
+        if (!print_raw(p, esc, print_escape(token, esc))) return 0;
+        run = ptr + 1;
     }
+    if (ptr > run && !print_raw(p, run, ptr - run)) return 0;
+    if (!print_raw(p, "\"", 1)) return 0;
+    return total;
+}
 
-    ptr = str;
-    while ((token = *ptr) && ++len) {       // 计算转义后的字符串长度，\X 多占 1 个字符 以及 ASCII 控制字符 \uXXXX 多占用 5 个字符
-        if (strchr("\"\\\b\f\n\r\t", token)) len++;
-        else if (token < 32) len += 5;
-        ptr++;
-    }
+/**
+ * @brief 将提供的 string 渲染为带引号的转义版本，追加到缓冲区
+ *
+ * 先扫描一遍算出转义后的长度，一次 ensure 到位后再写入；无需转义时直接整段拷贝。
+ *
+ * @param str 指向要打印的字符串的指针，NULL 视为空串
+ * @param p 指向 printbuffer 的指针
+ * @return size_t 返回写入的字节数，失败时返回 0
+ */
+static size_t print_string_ptr(const char *str, printbuffer *p) {
+    const unsigned char *ptr;
+    char *ptr2, *out;
+    size_t len = 0, escaped = 0;
+    unsigned char token;
 
-    if (p) out = ensure(p, len + 3);
-    else out = (char *) cJSON_malloc(len + 3);
+    if (!str) return print_raw(p, "\"\"", 2);
 
-    if (!out) return NULL;
+    for (ptr = (const unsigned char *) str; (token = *ptr); ptr++) {  // 计算转义后多出的长度
+        if (token == '\"' || token == '\\') escaped++;
+        else if (token < 32) escaped += strchr("\b\f\n\r\t", token) ? 1 : 5;  // \X 多 1 个字符，\u00XX 多 5 个字符
+    }
+    len = (const char *) ptr - str;
+    if (p->write && len + escaped + 2 > p->length) return print_string_runs(str, len, len + escaped + 2, p);
 
+    if (!(out = ensure(p, len + escaped + 2))) return 0;
     ptr2 = out;
-    ptr = str;
     *ptr2++ = '\"';
-    while (*ptr) {
-        if ((unsigned char) *ptr > 31 && *ptr != '\"' && *ptr != '\\') *ptr2++ = *ptr++;
-        else {
-            *ptr2++ = '\\';
-            switch (token = *ptr++) {
-                case '\\':
-                    *ptr2++ = '\\';
-                    break;
-                case '\"':
-                    *ptr2++ = '\"';
-                    break;
-                case '\b':
-                    *ptr2++ = 'b';
-                    break;
-                case '\f':
-                    *ptr2++ = 'f';
-                    break;
-                case '\n':
-                    *ptr2++ = 'n';
-                    break;
-                case '\r':
-                    *ptr2++ = 'r';
-                    break;
-                case '\t':
-                    *ptr2++ = 't';
-                    break;
-                default:
-                    sprintf(ptr2, "u%04x", token);
-                    ptr2 += 5;
-                    break;
-            }
+    if (!escaped) {
+        memcpy(ptr2, str, len);
+        ptr2 += len;
+    } else {
+        for (ptr = (const unsigned char *) str; (token = *ptr); ptr++) {
+            if (token > 31 && token != '\"' && token != '\\') *ptr2++ = (char) token;
+            else ptr2 += print_escape(token, ptr2);
         }
     }
     *ptr2++ = '\"';
-    *ptr2 = 0;
-    return out;
+    p->offset += ptr2 - out;
+    return ptr2 - out;
 }
 
 /**
  * @brief 利用 print_string_ptr 将 cJSON 对象的字符串打印到缓冲区
  *
  * @param item cJSON 对象
- * @param p 指向 printbuffer 的指针，用于存储转换后的字符串
- * @return char* 成功时返回转换后的字符串，失败时返回 NULL
- */static char *print_string(cJSON *item, printbuffer *p) {
+ * @param p 指向 printbuffer 的指针
+ * @return size_t 返回写入的字节数，失败时返回 0
+ */
+static size_t print_string(const cJSON *item, printbuffer *p) {
     return print_string_ptr(item->valuestring, p);
 }
 
@@ -409,56 +1691,280 @@ static const char *parse_string(cJSON *item, const char *str) {
  * @brief 跳过空白字符
  *
  * @param in 指向字符串的指针
- * @return const char* 返回跳过空白字符后的指针位置
+ * @param s 解析状态
+ * @return const char* 返回跳过空白字符后的指针位置，不会越过 s->end
  */
-static const char *skip(const char *in) {
-    while (in && *in && (unsigned char) *in <= 32) in++;
-    return in;
+static const char *skip(const char *in, const parsestate *s) {
+    if (!in || in >= s->end || (unsigned char) *in > 32) return in;     // 紧凑输入中大多数位置无需跳过
+    return skip_whitespace(in, s->end);
 }
 
-/* 先声明核心解析/输出函数 */
-static const char *parse_value(cJSON *item, const char *value);
+/*
+ * 显式容器栈
+ * 解析、打印和复制都用它代替递归，栈空间与嵌套深度无关。浅层放在调用者的栈上，更深时转到堆上。
+ */
+#ifndef CJSON_TREE_STACK
+#define CJSON_TREE_STACK 32     // 栈上容器栈的深度
+#endif
 
-static const char *parse_array(cJSON *item, const char *value);
+typedef struct {
+    cJSON *container;       // 打开的容器（复制时为副本）
+    cJSON *last;            // 解析和复制：已追加的最后一个成员
+    const cJSON *source;    // 复制：下一个要复制的原成员
+} treeframe;
+
+typedef struct {
+    treeframe *frames;
+    size_t depth;
+    size_t capacity;
+    treeframe inline_frames[CJSON_TREE_STACK];
+} treestack;
+
+static void treestack_init(treestack *st) {
+    st->frames = st->inline_frames;
+    st->depth = 0;
+    st->capacity = CJSON_TREE_STACK;
+}
 
-static const char *parse_object(cJSON *item, const char *value);
+/* 压入一层并返回它，内存不足时返回 NULL */
+static treeframe *treestack_push(treestack *st) {
+    treeframe *frames;
+    if (st->depth == st->capacity) {
+        if (!(frames = (treeframe *) cJSON_malloc(st->capacity * 2 * sizeof(treeframe)))) return NULL;
+        memcpy(frames, st->frames, st->depth * sizeof(treeframe));
+        if (st->frames != st->inline_frames) cJSON_free(st->frames);
+        st->frames = frames;
+        st->capacity *= 2;
+    }
+    return &st->frames[st->depth++];
+}
 
-static char *print_value(cJSON *item, int depth, cJSON_bool fmt, printbuffer *p);
+static void treestack_free(treestack *st) {
+    if (st->frames != st->inline_frames) cJSON_free(st->frames);
+}
 
-static char *print_array(cJSON *item, int depth, cJSON_bool fmt, printbuffer *p);
+/* 先声明核心解析/输出函数 */
+static const char *parse_value(cJSON *item, const char *value, parsestate *s);
+
+static size_t print_value(const cJSON *item, int depth, cJSON_bool fmt, printbuffer *p);
+
+/* 填写错误信息：错误码，以及 ep 相对输入开头的字节偏移和行列号（从 1 开始，ep 不在输入内时为 0） */
+static void locate_error(cJSON_Error *error, int code, const char *start, const char *end) {
+    const char *line = start, *nl;
+    error->code = code;
+    error->offset = error->line = error->column = 0;
+    if (code == cJSON_ErrorNone || !ep || ep < start || ep > end) return;
+    error->offset = (size_t) (ep - start);
+    error->line = 1;
+    while ((nl = (const char *) memchr(line, '\n', ep - line))) {
+        error->line++;
+        line = nl + 1;
+    }
+    error->column = (size_t) (ep - line) + 1;
+}
 
-static char *print_object(cJSON *item, int depth, cJSON_bool fmt, printbuffer *p);
+/* 把解析结果记到上下文中 */
+static void context_error(cJSON_Context *ctx, int code, const char *start, const char *end) {
+    locate_error(&ctx->error, code, start, end);
+}
 
 /**
- * @brief 使用可选参数解析 JSON 字符串并创建 cJSON 对象
+ * @brief 按给定的解析状态解析 JSON 文本并创建 cJSON 对象
  *
- * @param value 指向 JSON 字符串的指针
+ * 所有扫描都以 value + length 为界，不依赖也不会读取末尾之后的 \0。
+ *
+ * @param value 指向 JSON 文本的指针
+ * @param length 文本长度
  * @param return_parse_end 可选参数，用于返回解析结束的位置
- * @param require_null_terminated 如果为真，则要求 JSON 字符串以 null 结尾
+ * @param require_null_terminated 如果为真，则要求值之后直到末尾只有空白
+ * @param s 解析状态
  * @return cJSON* 成功时返回新创建的 cJSON 对象，失败时返回 NULL
  */
-cJSON *cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated) {
+static cJSON *parse_root(const char *value, size_t length, const char **return_parse_end,
+                         cJSON_bool require_null_terminated, parsestate *s) {
+    cJSON_Context *ctx = thread_context;
     const char *end = NULL;
-    cJSON *c = cJSON_New_Item();
+    cJSON *c = NULL;
     ep = NULL;
-    if (!c) return NULL; /* 内存分配失败 */
+    if (!value) return NULL; /* 无效输入 */
+    s->end = value + length;
+    s->max_depth = CJSON_NESTING_LIMIT;
+    if (ctx) {
+        s->max_depth = ctx->limits.max_depth;
+        if (ctx->limits.max_length && length > ctx->limits.max_length) {
+            s->error = cJSON_ErrorLength;
+            ep = value + ctx->limits.max_length;
+        }
+    }
 
-    end = parse_value(c, skip(value));
+    if (!s->error && (c = parse_new_item(s))) end = parse_value(c, skip(value, s), s);
+
+    /* 如果需要以 \0 结尾，则检查值之后是否已到输入末尾 */
+    if (end && require_null_terminated) {
+        end = skip(end, s);
+        if (end < s->end) {
+            ep = end;
+            end = NULL;
+        }
+    }
+    if (ctx) context_error(ctx, end ? cJSON_ErrorNone : s->error ? s->error : cJSON_ErrorSyntax, value, s->end);
     if (!end) {
         cJSON_Delete(c);
         return NULL;
     } /* 解析失败 */
+    if (return_parse_end) *return_parse_end = end;
+    return c;
+}
 
-    /* 如果需要以 \0 结尾，则检查是否以 \0 结尾 */
-    if (require_null_terminated) {
-        end = skip(end);
-        if (*end) {
-            cJSON_Delete(c);
-            ep = end;
+/**
+ * @brief 使用可选参数解析 JSON 字符串并创建 cJSON 对象
+ *
+ * @param value 指向 JSON 字符串的指针
+ * @param return_parse_end 可选参数，用于返回解析结束的位置
+ * @param require_null_terminated 如果为真，则要求 JSON 字符串以 null 结尾
+ * @return cJSON* 成功时返回新创建的 cJSON 对象，失败时返回 NULL
+ */
+cJSON *cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated) {
+    parsestate s = {};
+    return parse_root(value, value ? strlen(value) : 0, return_parse_end, require_null_terminated, &s);
+}
+
+/**
+ * @brief 解析长度为 buffer_length 的 JSON 文本，文本不需要以 \0 结尾
+ *
+ * @param value 指向 JSON 文本的指针
+ * @param buffer_length 文本长度
+ * @param return_parse_end 可选参数，用于返回解析结束的位置
+ * @param require_null_terminated 如果为真，则要求值之后直到末尾只有空白
+ * @return cJSON* 成功时返回新创建的 cJSON 对象，失败时返回 NULL
+ */
+cJSON *cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end,
+                                 cJSON_bool require_null_terminated) {
+    parsestate s = {};
+    return parse_root(value, buffer_length, return_parse_end, require_null_terminated, &s);
+}
+
+cJSON *cJSON_ParseWithLength(const char *value, size_t buffer_length) {
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+cJSON *cJSON_ParseWithArenaOpts(cJSON_Arena *arena, const char *value, const char **return_parse_end,
+                                cJSON_bool require_null_terminated) {
+    parsestate s = {};
+    if (!arena) return NULL;
+    s.arena = arena;
+    return parse_root(value, value ? strlen(value) : 0, return_parse_end, require_null_terminated, &s);
+}
+
+cJSON *cJSON_ParseWithArena(cJSON_Arena *arena, const char *value) {
+    return cJSON_ParseWithArenaOpts(arena, value, 0, 0);
+}
+
+/**
+ * @brief 就地解析可写缓冲区中的 JSON 文本
+ *
+ * 字符串在缓冲区内反转义，valuestring 和 string 直接指向缓冲区，不再逐个分配和拷贝。
+ * 整个缓冲区必须恰好是一个 JSON 值（允许前后空白），不需要以 \0 结尾。
+ *
+ * @param buf 可写的 JSON 文本
+ * @param len 文本长度
+ * @return cJSON* 成功时返回新创建的 cJSON 对象，失败时返回 NULL
+ */
+cJSON *cJSON_ParseInSitu(char *buf, size_t len) {
+    parsestate s = {};
+    s.insitu = 1;
+    return parse_root(buf, len, 0, 1, &s);
+}
+
+cJSON *cJSON_ParseWithFlags(const char *value, size_t length, int flags) {
+    parsestate s = {};
+    s.keep_number_text = (flags & cJSON_KeepNumberText) != 0;
+    return parse_root(value, length, 0, 1, &s);
+}
+
+/* 解析失败后输入即将被释放：把出错位置之后的一小段文本复制出来，使 cJSON_GetErrorPtr() 仍然可用 */
+static void keep_error_context(const char *buffer, size_t length) {
+    static thread_local char context[64];
+    size_t n;
+    if (!ep || ep < buffer || ep > buffer + length) return;
+    n = (size_t) (buffer + length - ep);
+    if (n > sizeof(context) - 1) n = sizeof(context) - 1;
+    memcpy(context, ep, n);
+    context[n] = 0;
+    ep = context;
+}
+
+/* 读取整个文件到新分配的缓冲区，不要求文件可定位（管道、设备等） */
+static char *read_file(FILE *file, size_t *length) {
+    size_t size = 64 * 1024, used = 0, n;
+    char *buffer = (char *) cJSON_malloc(size), *newbuffer;
+    while (buffer && (n = fread(buffer + used, 1, size - used, file)) > 0) {
+        used += n;
+        if (used < size) continue;
+        if (!(newbuffer = (char *) cJSON_malloc(size * 2))) {
+            cJSON_free(buffer);
             return NULL;
         }
+        memcpy(newbuffer, buffer, used);
+        cJSON_free(buffer);
+        buffer = newbuffer;
+        size *= 2;
     }
-    if (return_parse_end) *return_parse_end = end;
+    if (buffer && ferror(file)) {
+        cJSON_free(buffer);
+        return NULL;
+    }
+    *length = used;
+    return buffer;
+}
+
+/**
+ * @brief 解析 JSON 文件
+ *
+ * 普通文件用 mmap 映射后按长度直接解析，不经过任何中间拷贝，并以 MADV_SEQUENTIAL 提示内核预读；
+ * 无法映射时（空文件、管道或不支持 mmap 的平台）退回到整块读取。
+ *
+ * @param path 文件路径
+ * @return cJSON* 成功时返回新创建的 cJSON 对象，失败时返回 NULL；无法打开或读取文件时 cJSON_GetErrorPtr() 为 NULL
+ */
+cJSON *cJSON_ParseFile(const char *path) {
+    FILE *file;
+    char *buffer;
+    size_t length = 0;
+    cJSON *c;
+    ep = NULL;
+    if (!path) return NULL;
+#ifdef CJSON_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    void *map;
+    if (fd < 0) return NULL;
+    if (!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64_t) st.st_size <= SIZE_MAX) {
+        length = (size_t) st.st_size;
+        map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            close(fd);
+            madvise(map, length, MADV_SEQUENTIAL);
+            c = cJSON_ParseWithLength((const char *) map, length);
+            if (!c) keep_error_context((const char *) map, length);
+            munmap(map, length);
+            return c;
+        }
+    }
+    file = fdopen(fd, "rb");
+    if (!file) {
+        close(fd);
+        return NULL;
+    }
+#else
+    if (!(file = fopen(path, "rb"))) return NULL;
+#endif
+    buffer = read_file(file, &length);
+    fclose(file);
+    if (!buffer) return NULL;
+    c = cJSON_ParseWithLength(buffer, length);
+    if (!c) keep_error_context(buffer, length);
+    cJSON_free(buffer);
     return c;
 }
 
@@ -472,6 +1978,35 @@ cJSON *cJSON_Parse(const char *value) {
     return cJSON_ParseWithOpts(value, 0, 0);
 }
 
+/**
+ * @brief 用给定的初始缓冲区大小把 cJSON 对象打印为以 \0 结尾的字符串
+ *
+ * 所有输出函数都直接追加到同一块缓冲区，缓冲区按 2 的幂扩容，
+ * 因此耗时与输出长度成线性关系，只需 O(log n) 次分配。
+ *
+ * @param item cJSON 对象
+ * @param prebuffer 缓冲区的初始大小
+ * @param fmt 是否格式化
+ * @return char* 成功时返回转换后的字符串，失败时返回 NULL
+ */
+static char *print_root(const cJSON *item, size_t prebuffer, cJSON_bool fmt) {
+    printbuffer p;
+    if (!item) return NULL;
+    p.buffer = (char *) cJSON_malloc(prebuffer);
+    if (!p.buffer) return NULL;
+    p.length = prebuffer;
+    p.offset = 0;
+    p.write = NULL;
+    p.ctx = NULL;
+    p.noalloc = 0;
+    if (!print_value(item, 0, fmt, &p) || !ensure(&p, 1)) {
+        if (p.buffer) cJSON_free(p.buffer);
+        return NULL;
+    }
+    p.buffer[p.offset] = 0;
+    return p.buffer;
+}
+
 /**
  * @brief 将 cJSON 对象转换为 JSON 字符串
  *
@@ -479,7 +2014,7 @@ cJSON *cJSON_Parse(const char *value) {
  * @return char* 成功时返回转换后的字符串，失败时返回 NULL
  */
 char *cJSON_Print(cJSON *item) {
-    return print_value(item, 0, 1, 0);
+    return print_root(item, CJSON_PRINT_DEFAULT_BUFFER, 1);
 }
 
 /**
@@ -489,7 +2024,7 @@ char *cJSON_Print(cJSON *item) {
  * @return char* 成功时返回转换后的字符串，失败时返回 NULL
  */
 char *cJSON_PrintUnformatted(cJSON *item) {
-    return print_value(item, 0, 0, 0);
+    return print_root(item, CJSON_PRINT_DEFAULT_BUFFER, 0);
 }
 
 /**
@@ -501,508 +2036,2023 @@ char *cJSON_PrintUnformatted(cJSON *item) {
  * @return char* 成功时返回转换后的字符串，失败时返回 NULL
  */
 char *cJSON_PrintBuffered(cJSON *item, int prebuffer, cJSON_bool fmt) {
+    return print_root(item, prebuffer > 0 ? (size_t) prebuffer : CJSON_PRINT_DEFAULT_BUFFER, fmt);
+}
+
+/* 经过 chunk 把 item 流式输出到 write_fn */
+static cJSON_bool print_chunked(const cJSON *item, cJSON_bool fmt, cJSON_WriteCallback write_fn, void *ctx,
+                                char *chunk, size_t size) {
     printbuffer p;
-    p.buffer = (char *) cJSON_malloc((size_t) prebuffer);
-    p.length = (size_t) prebuffer;
+    p.buffer = chunk;
+    p.length = size;
     p.offset = 0;
-    return print_value(item, 0, fmt, &p);
+    p.write = write_fn;
+    p.ctx = ctx;
+    p.noalloc = 0;
+    return print_value(item, 0, fmt, &p) && print_flush(&p);
 }
 
 /**
- * @brief 解析一个 JSON 值并将其添加到 cJSON 对象中
+ * @brief 将 cJSON 对象流式输出到回调函数
+ *
+ * 输出经过栈上固定大小的块，写满即交给回调，因此首批数据在整棵树序列化完成前就已送出。
  *
  * @param item cJSON 对象
- * @param value 指向 JSON 字符串的指针
- * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
+ * @param fmt 是否格式化
+ * @param write_fn 输出回调
+ * @param ctx 回调的用户数据
+ * @return cJSON_bool 全部写出返回 1，失败返回 0
  */
-static const char *parse_value(cJSON *item, const char *value) {
-    if (!value) return NULL; // 无效输入
+cJSON_bool cJSON_PrintToWriter(cJSON *item, cJSON_bool fmt, cJSON_WriteCallback write_fn, void *ctx) {
+    char chunk[CJSON_WRITER_CHUNK];
+    if (!item || !write_fn) return 0;
+    return print_chunked(item, fmt, write_fn, ctx, chunk, sizeof(chunk));
+}
+
+/* 把数据写入 ctx 指向的 FILE */
+static cJSON_bool write_file(const char *data, size_t length, void *ctx) {
+    return fwrite(data, 1, length, (FILE *) ctx) == length;
+}
+
+/**
+ * @brief 将 cJSON 对象写入文件
+ *
+ * 输出经过堆上 CJSON_FILE_CHUNK 大小的块直接写入无缓冲的文件流，不生成完整的字符串；
+ * 每次写入接近一整块，也省去了 stdio 缓冲区的一次拷贝。
+ *
+ * @param item cJSON 对象
+ * @param path 文件路径，已存在时覆盖
+ * @param fmt 是否格式化
+ * @return cJSON_bool 全部写出返回 1，失败返回 0（文件可能只写了一部分）
+ */
+cJSON_bool cJSON_PrintToFile(cJSON *item, const char *path, cJSON_bool fmt) {
+    FILE *file;
+    char *chunk;
+    cJSON_bool ok;
+    if (!item || !path) return 0;
+    if (!(chunk = (char *) cJSON_malloc(CJSON_FILE_CHUNK))) return 0;
+    if (!(file = fopen(path, "wb"))) {
+        cJSON_free(chunk);
+        return 0;
+    }
+    setvbuf(file, NULL, _IONBF, 0);
+    ok = print_chunked(item, fmt, write_file, file, chunk, CJSON_FILE_CHUNK);
+    if (fclose(file)) ok = 0;
+    cJSON_free(chunk);
+    return ok;
+}
+
+/* 只统计字节数的输出回调，用于计算所需的缓冲区大小 */
+static cJSON_bool count_bytes(const char *data, size_t length, void *ctx) {
+    (void) data;
+    *(size_t *) ctx += length;
+    return 1;
+}
+
+/**
+ * @brief 将 cJSON 对象打印到调用者提供的缓冲区，不分配任何内存
+ *
+ * @param item cJSON 对象
+ * @param buffer 调用者提供的缓冲区；为 NULL 或 length 为 0 时不输出，只在 required 中写入所需的大小
+ * @param length 缓冲区大小（含结尾的 \0）
+ * @param fmt 是否格式化
+ * @param required 可选，失败时写入所需的缓冲区大小（含 \0）；成功时写入实际使用的大小
+ * @return cJSON_bool 成功返回 1，缓冲区不足或 item 无效返回 0
+ */
+cJSON_bool cJSON_PrintPreallocated(cJSON *item, char *buffer, size_t length, cJSON_bool fmt, size_t *required) {
+    printbuffer p;
+    size_t count = 0;
+    if (required) *required = 0;
+    if (!item) return 0;
+    if (!buffer || !length) {   // 只查询所需大小
+        if (required && cJSON_PrintToWriter(item, fmt, count_bytes, &count)) *required = count + 1;
+        return 0;
+    }
+    p.buffer = buffer;
+    p.length = length - 1;  // 为 \0 预留一个字节
+    p.offset = 0;
+    p.write = NULL;
+    p.ctx = NULL;
+    p.noalloc = 1;
+    if (print_value(item, 0, fmt, &p)) {
+        buffer[p.offset] = 0;
+        if (required) *required = p.offset + 1;
+        return 1;
+    }
+    if (required && cJSON_PrintToWriter(item, fmt, count_bytes, &count)) *required = count + 1;   // 放不下时再数一遍所需大小
+    return 0;
+}
+
+/* 解析标量值（null、true、false、字符串或数字）并写入 item */
+static const char *parse_scalar(cJSON *item, const char *value, parsestate *s) {
+    if (value >= s->end) {
+        ep = value;
+        return NULL;    // 输入已结束
+    }
 
-    if (!strncmp(value, "null", 4)) {       // 解析 null
-        item->type = cJSON_NULL;
+    if (s->end - value >= 4 && !memcmp(value, "null", 4)) {       // 解析 null
+        item->type |= cJSON_NULL;
         return value + 4;
     }
 
-    if (!strncmp(value, "false", 5)) {      // 解析 false
-        item->type = cJSON_False;
+    if (s->end - value >= 5 && !memcmp(value, "false", 5)) {      // 解析 false
+        item->type |= cJSON_False;
         return value + 5;
     }
 
-    if (!strncmp(value, "true", 4)) {
-        item->type = cJSON_True;            // 解析 true
+    if (s->end - value >= 4 && !memcmp(value, "true", 4)) {
+        item->type |= cJSON_True;           // 解析 true
         item->valueint = 1;
         return value + 4;
     }
 
     if (*value == '\"') {                   // 解析字符串
-        return parse_string(item, value);
+        return parse_string(item, value, s);
     }
 
     if (*value == '-' || (*value >= '0' && *value <= '9')) { // 解析数字
-        return parse_number(item, value);
-    }
-
-    if (*value == '[') {
-        return parse_array(item, value);
-    }
-
-    if (*value == '{') {
-        return parse_object(item, value);
+        return parse_number(item, value, s);
     }
 
     ep = value;
     return NULL;                        // 无法解析
 }
 
-/**
- * @brief 解析 JSON 数组
- *
- * @param item cJSON 对象
- * @param value 指向 JSON 字符串的指针
- * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
- */
-static const char *parse_array(cJSON *item, const char *value) {
-    cJSON *child;
-    if (*value != '[') {
-        ep = value;
+/* 在 frame 的容器末尾追加一个新成员，对象成员先解析键和冒号。返回值的起始位置，新成员由 *item 带回 */
+static const char *parse_member(treeframe *frame, const char *value, parsestate *s, cJSON **item) {
+    cJSON *child = parse_new_item(s);
+    if (!child) return NULL; // 内存分配失败
+
+    if (frame->last) {
+        frame->last->next = child;
+        child->prev = frame->last;
+    } else {
+        frame->container->child = child;
+    }
+    frame->last = child;
+
+    if (frame->container->type & cJSON_Object) {
+        value = skip(parse_string(child, value, s), s);
+        if (!value) return NULL; // 解析失败
+
+        child->string = child->valuestring;
+        child->valuestring = NULL;
+        child->keyhash = key_hash(child->string);
+        child->type &= ~cJSON_String;   // 键已取走，类型由后面的值决定
+
+        if (peek(value, s) != ':') {
+            ep = value;
+            return NULL;
+        } // 非法输入
+        value = skip(value + 1, s);
+    }
+    *item = child;
+    return value;
+}
+
+/**
+ * @brief 解析一个 JSON 值（可以是任意深度的数组或对象）并写入 item
+ *
+ * 用显式的容器栈代替递归：打开容器时压栈并转去解析第一个成员，一个值结束后逐层处理逗号和结束符。
+ * 嵌套层数超过 s->max_depth（非 0 时）报错。失败时已建立的部分仍挂在 item 下，由调用者释放。
+ *
+ * @param item cJSON 对象
+ * @param value 指向 JSON 字符串的指针
+ * @param s 解析状态
+ * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
+ */
+static const char *parse_value(cJSON *item, const char *value, parsestate *s) {
+    treestack st;
+    treeframe *frame;
+    char token;
+
+    if (!value) return NULL; // 无效输入
+    treestack_init(&st);
+    for (;;) {
+        token = peek(value, s);
+        if (token == '[' || token == '{') {
+            if (s->max_depth && st.depth >= s->max_depth) {
+                s->error = cJSON_ErrorDepth;
+                ep = value;
+                value = NULL;
+                break;
+            }
+            if (!(frame = treestack_push(&st))) {
+                s->error = cJSON_ErrorMemory;
+                value = NULL;
+                break;
+            }
+            item->type |= token == '[' ? cJSON_Array : cJSON_Object;
+            frame->container = item;
+            frame->last = NULL;
+            value = skip(value + 1, s);
+            if (peek(value, s) != (token == '[' ? ']' : '}')) {   // 转去解析第一个成员
+                if (!(value = parse_member(frame, value, s, &item))) break;
+                continue;
+            }
+            st.depth--;         // 空容器
+            value++;
+        } else if (!(value = parse_scalar(item, value, s))) {
+            break;
+        }
+
+        /* 值已结束：遇到逗号时转去解析下一个成员，遇到结束符时关闭容器并回到上一层 */
+        while (st.depth) {
+            frame = &st.frames[st.depth - 1];
+            value = skip(value, s);
+            if (peek(value, s) == ',') {
+                value = parse_member(frame, skip(value + 1, s), s, &item);
+                break;
+            }
+            if (peek(value, s) != (frame->container->type & cJSON_Array ? ']' : '}')) {
+                ep = value;
+                value = NULL;
+                break;
+            }
+            frame->container->child->prev = frame->last;  // 首节点的 prev 指向尾节点
+            st.depth--;
+            value++;
+        }
+        if (!value || !st.depth) break;
+    }
+    treestack_free(&st);
+    return value;
+}
+
+/*
+ * 校验
+ * 与 parse_value 相同的迭代结构，但每层只需记住容器是数组还是对象，用栈上的位图代替容器栈，
+ * 因此不分配内存。字符串中的普通 ASCII 字符由 SIMD 成块跳过，只在转义和非 ASCII 字节处逐个检查。
+ */
+
+/* 跳过 RFC 8259 定义的空白 */
+static inline const char *validate_skip(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    return p;
+}
+
+/* 读取 4 位十六进制数字，不合法时返回 -1 */
+static long validate_hex4(const char *p) {
+    long h = 0;
+    int i;
+    for (i = 0; i < 4; i++) {
+        h <<= 4;
+        if (p[i] >= '0' && p[i] <= '9') h |= p[i] - '0';
+        else if (p[i] >= 'A' && p[i] <= 'F') h |= p[i] - ('A' - 10);
+        else if (p[i] >= 'a' && p[i] <= 'f') h |= p[i] - ('a' - 10);
+        else return -1;
+    }
+    return h;
+}
+
+/* 检查 p 处的多字节 UTF-8 序列，返回它的长度；过长编码、代理项、超过 U+10FFFF 或被截断时返回 0 */
+static int validate_utf8(const unsigned char *p, const unsigned char *end) {
+    unsigned char lo = 0x80, hi = 0xBF;     // 第二个字节的范围
+    int n, i;
+    if (*p < 0xC2 || *p > 0xF4) return 0;
+    n = *p < 0xE0 ? 2 : *p < 0xF0 ? 3 : 4;
+    if (*p == 0xE0) lo = 0xA0;
+    else if (*p == 0xED) hi = 0x9F;
+    else if (*p == 0xF0) lo = 0x90;
+    else if (*p == 0xF4) hi = 0x8F;
+    if (end - p < n || p[1] < lo || p[1] > hi) return 0;
+    for (i = 2; i < n; i++)
+        if ((p[i] & 0xC0) != 0x80) return 0;
+    return n;
+}
+
+/* 校验一个字符串，成功时返回结束引号之后的位置；失败时返回 NULL，ep 指向出错位置，*code 为错误码 */
+static const char *validate_string(const char *p, const char *end, int *code) {
+    long uc, uc2;
+    int n;
+    p++;    // 跳过开始的引号
+    for (;;) {
+        p = scan_plain(p, end);
+        if (p >= end) {     // 没有找到字符串的结束
+            ep = end;
+            return NULL;
+        }
+        if (*p == '\"') return p + 1;
+        if (*p == '\\') {
+            if (end - p < 2) {
+                ep = p;
+                return NULL;
+            }
+            switch (p[1]) {
+                case '\"':
+                case '\\':
+                case '/':
+                case 'b':
+                case 'f':
+                case 'n':
+                case 'r':
+                case 't':
+                    p += 2;
+                    break;
+                case 'u':
+                    if (end - p < 6 || (uc = validate_hex4(p + 2)) < 0) {
+                        ep = p;
+                        return NULL;
+                    }
+                    if (uc >= 0xDC00 && uc <= 0xDFFF) {     // 单独的低位代理项
+                        *code = cJSON_ErrorEncoding;
+                        ep = p;
+                        return NULL;
+                    }
+                    if (uc >= 0xD800 && uc <= 0xDBFF) {     // 高位代理项之后必须紧跟低位代理项
+                        if (end - p < 12 || p[6] != '\\' || p[7] != 'u' ||
+                            (uc2 = validate_hex4(p + 8)) < 0xDC00 || uc2 > 0xDFFF) {
+                            *code = cJSON_ErrorEncoding;
+                            ep = p;
+                            return NULL;
+                        }
+                        p += 6;
+                    }
+                    p += 6;
+                    break;
+                default:    // 未知转义
+                    ep = p;
+                    return NULL;
+            }
+        } else if ((unsigned char) *p < 0x20) {  // 未转义的控制字符
+            ep = p;
+            return NULL;
+        } else {
+            do {    // 连续的非 ASCII 字符逐个检查，不回到 SIMD 扫描
+                if (!(n = validate_utf8((const unsigned char *) p, (const unsigned char *) end))) {
+                    *code = cJSON_ErrorEncoding;
+                    ep = p;
+                    return NULL;
+                }
+                p += n;
+            } while (p < end && (unsigned char) *p >= 0x80);
+        }
+    }
+}
+
+/* 校验对象成员的键和冒号，返回值的起始位置 */
+static const char *validate_key(const char *p, const char *end, int *code) {
+    if (p >= end || *p != '\"') {
+        ep = p;
+        return NULL;
+    }
+    if (!(p = validate_string(p, end, code))) return NULL;
+    p = validate_skip(p, end);
+    if (p >= end || *p != ':') {
+        ep = p;
+        return NULL;
+    }
+    return validate_skip(p + 1, end);
+}
+
+cJSON_bool cJSON_Validate(const char *value, size_t length, cJSON_Error *error) {
+    unsigned char objects[(CJSON_NESTING_LIMIT + 7) / 8];   // 每层一位，为 1 时是对象
+    const char *p = value, *end = value + length;
+    size_t depth = 0;
+    int code = cJSON_ErrorSyntax, object;
+
+    ep = NULL;
+    if (!value) {
+        if (error) error->code = cJSON_ErrorSyntax, error->offset = error->line = error->column = 0;
+        return 0;
+    }
+    p = validate_skip(p, end);
+    for (;;) {
+        if (p >= end) {
+            ep = p;
+            p = NULL;
+            break;
+        }
+        switch (*p) {
+            case '[':
+            case '{':
+                if (depth >= CJSON_NESTING_LIMIT) {
+                    code = cJSON_ErrorDepth;
+                    ep = p;
+                    p = NULL;
+                    break;
+                }
+                object = *p == '{';
+                if (object) objects[depth >> 3] |= (unsigned char) (1u << (depth & 7));
+                else objects[depth >> 3] &= (unsigned char) ~(1u << (depth & 7));
+                depth++;
+                p = validate_skip(p + 1, end);
+                if (p < end && *p == (object ? '}' : ']')) {    // 空容器
+                    depth--;
+                    p++;
+                } else if (!object || (p = validate_key(p, end, &code))) {
+                    continue;   // 转去校验第一个成员（的值）
+                }
+                break;
+            case '\"':
+                p = validate_string(p, end, &code);
+                break;
+            case 't':
+                p = end - p >= 4 && !memcmp(p, "true", 4) ? p + 4 : (ep = p, nullptr);
+                break;
+            case 'f':
+                p = end - p >= 5 && !memcmp(p, "false", 5) ? p + 5 : (ep = p, nullptr);
+                break;
+            case 'n':
+                p = end - p >= 4 && !memcmp(p, "null", 4) ? p + 4 : (ep = p, nullptr);
+                break;
+            default:
+                p = validate_number(p, end);
+                break;
+        }
+        if (!p) break;
+
+        /* 值已结束：逗号之后校验下一个成员，结束符关闭容器回到上一层 */
+        while (depth) {
+            object = (objects[(depth - 1) >> 3] >> ((depth - 1) & 7)) & 1;
+            p = validate_skip(p, end);
+            if (p < end && *p == ',') {
+                p = validate_skip(p + 1, end);
+                if (object) p = validate_key(p, end, &code);
+                break;
+            }
+            if (p >= end || *p != (object ? '}' : ']')) {
+                ep = p;
+                p = NULL;
+                break;
+            }
+            depth--;
+            p++;
+        }
+        if (!p || !depth) break;
+    }
+
+    if (p && (p = validate_skip(p, end)) < end) {     // 值之后只允许空白
+        ep = p;
+        p = NULL;
+    }
+    if (error) locate_error(error, p ? cJSON_ErrorNone : code, value, end);
+    return p != NULL;
+}
+
+/*
+ * 按需解析
+ * 惰性容器带 cJSON_IsLazy | cJSON_IsInSitu 标记，child 为空，valuestring 指向输入中的 '[' 或 '{'，
+ * valuedouble 为整个容器的字节数。第一次通过库函数访问它的子节点时才解析这一层：标量成员直接建立节点，
+ * 嵌套的容器只用括号匹配跳过并记下范围，仍是惰性的。因此查询的代价只与走过的层数和跳过的字节数有关。
+ * 括号匹配只检查括号是否成对、字符串是否结束，其余语法错误在展开所在的那一层时才发现。
+ */
+
+/*
+ * 跳过从 p（'[' 或 '{'）开始的整个容器，返回匹配的结束括号之后的位置，括号不成对或嵌套超过 max_depth（非 0 时）返回 NULL。
+ * 按 16 字节的块取出引号、反斜杠和括号的位置掩码，在掩码上逐位处理：字符串内只看结束引号和转义，
+ * 反斜杠直接清掉下一个字节的位（落在下一块时由 escaped 带过去）。
+ */
+static const char *lazy_skip(const char *p, const char *end, size_t max_depth) {
+    const char *block = (const char *) ((uintptr_t) p & ~(uintptr_t) 15);
+    unsigned mask, escaped = 0;
+    cJSON_bool in_string = 0;
+    size_t depth = 0;
+    int i;
+    for (; block < end; block += 16) {
+        mask = structural_mask(block, p, end) & ~escaped;
+        escaped = 0;
+        while (mask) {
+            i = __builtin_ctz(mask);
+            mask &= mask - 1;
+            if (in_string) {
+                if (block[i] == '\"') in_string = 0;
+                else if (block[i] == '\\') {
+                    if (i == 15) escaped = 1;
+                    else mask &= ~(1u << (i + 1));
+                }
+            } else if (block[i] == '\"') {
+                in_string = 1;
+            } else if ((block[i] | 0x20) == '{') {
+                if (++depth > max_depth && max_depth) {
+                    ep = block + i;
+                    return NULL;
+                }
+            } else if (block[i] != '\\' && !--depth) {    // 字符串外的反斜杠留给展开时报错
+                return block + i + 1;
+            }
+        }
+    }
+    ep = end;
+    return NULL;    // 容器没有结束
+}
+
+/* 把 item 设为 start 处长度为 length 的惰性容器 */
+static void lazy_defer(cJSON *item, const char *start, size_t length) {
+    item->type |= (*start == '[' ? cJSON_Array : cJSON_Object) | cJSON_IsLazy | cJSON_IsInSitu;
+    item->valuestring = (char *) start;
+    item->valuedouble = (double) length;
+}
+
+/* 展开惰性容器的一层。失败时容器保持惰性，ep 指向出错位置 */
+static cJSON_bool lazy_expand(cJSON *item) {
+    parsestate s = {};
+    treeframe frame = {item, NULL, NULL};
+    const char *value = item->valuestring, *next;
+    char closer = *value == '[' ? ']' : '}';
+    cJSON *child;
+
+    s.end = value + (size_t) item->valuedouble;
+    value = skip(value + 1, &s);
+    if (peek(value, &s) == closer) value++;     // 空容器
+    else {
+        for (;;) {
+            if (!(value = parse_member(&frame, value, &s, &child))) break;
+            if (peek(value, &s) == '[' || peek(value, &s) == '{') {     // 嵌套的容器只记下范围
+                if ((next = lazy_skip(value, s.end, 0))) lazy_defer(child, value, next - value);
+                value = next;
+            } else {
+                value = parse_scalar(child, value, &s);
+            }
+            if (!(value = skip(value, &s))) break;
+            if (peek(value, &s) != ',') {
+                if (peek(value, &s) == closer) value++;
+                else {
+                    ep = value;
+                    value = NULL;
+                }
+                break;
+            }
+            value = skip(value + 1, &s);
+        }
+    }
+    if (!value) {
+        cJSON_Delete(item->child);
+        item->child = NULL;
+        return 0;
+    }
+    if (item->child) item->child->prev = frame.last;    // 首节点的 prev 指向尾节点
+    item->type &= ~(cJSON_IsLazy | cJSON_IsInSitu);
+    item->valuestring = NULL;
+    item->valuedouble = 0;
+    return 1;
+}
+
+/* 一次解析惰性容器的整个范围，得到完整的子树。逐层展开时每层都要重新跳过下面的内容，整棵展开用这个 */
+static cJSON_bool lazy_expand_all(cJSON *item) {
+    parsestate s = {};
+    const char *start = item->valuestring;
+    int type = item->type;
+
+    s.end = start + (size_t) item->valuedouble;     // 嵌套层数在跳过时已经检查过
+    item->type &= ~(255 | cJSON_IsLazy | cJSON_IsInSitu);
+    item->valuestring = NULL;
+    item->valuedouble = 0;
+    if (parse_value(item, start, &s) == s.end) return 1;
+    cJSON_Delete(item->child);  // 恢复为惰性容器
+    item->child = NULL;
+    item->type = type;
+    item->valuestring = (char *) start;
+    item->valuedouble = (double) (s.end - start);
+    return 0;
+}
+
+/* 访问子节点之前调用：惰性容器先展开一层。展开只是补齐已有的内容，因此也用于 const 的查询函数 */
+static inline cJSON_bool lazy_ready(const cJSON *item) {
+    return !(item->type & cJSON_IsLazy) || lazy_expand((cJSON *) item);
+}
+
+/* 输出、复制等要走遍整棵子树时调用：惰性容器整个展开 */
+static inline cJSON_bool lazy_complete(const cJSON *item) {
+    return !(item->type & cJSON_IsLazy) || lazy_expand_all((cJSON *) item);
+}
+
+cJSON *cJSON_ParseLazy(const char *value, size_t length) {
+    parsestate s = {};
+    const char *start, *end;
+    cJSON *c;
+
+    ep = NULL;
+    if (!value) return NULL;
+    s.end = value + length;
+    start = skip(value, &s);
+    if (peek(start, &s) != '[' && peek(start, &s) != '{') return cJSON_ParseWithLengthOpts(value, length, NULL, 1);
+
+    if (!(end = lazy_skip(start, s.end, CJSON_NESTING_LIMIT))) return NULL;
+    if (skip(end, &s) < s.end) {    // 值之后只允许空白
+        ep = skip(end, &s);
+        return NULL;
+    }
+    if (!(c = parse_new_item(&s))) return NULL;
+    lazy_defer(c, start, end - start);
+    if (!lazy_expand(c)) {  // 顶层总是立即展开，顶层的语法错误在这里就能发现
+        cJSON_Delete(c);
+        return NULL;
+    }
+    return c;
+}
+
+/* 展开 item 下面所有仍是惰性的容器：已展开的容器逐层检查，遇到惰性容器时整个展开，不再深入 */
+static cJSON_bool materialize_children(cJSON *item) {
+    treestack st;
+    treeframe *frame;
+    cJSON *c;
+
+    if ((item->type & cJSON_IsReference) || !item->child) return 1;
+    treestack_init(&st);
+    treestack_push(&st)->container = item->child;
+    while (st.depth) {
+        frame = &st.frames[st.depth - 1];
+        if (!(c = frame->container)) {
+            st.depth--;
+            continue;
+        }
+        frame->container = c->next;
+        if (!(c->type & (cJSON_Array | cJSON_Object)) || (c->type & cJSON_IsReference)) continue;
+        if (c->type & cJSON_IsLazy) {
+            if (!lazy_expand_all(c)) break;
+        } else if (c->child) {
+            if (!(frame = treestack_push(&st))) break;
+            frame->container = c->child;
+        }
+    }
+    treestack_free(&st);
+    return !st.depth;
+}
+
+cJSON_bool cJSON_Materialize(cJSON *item, cJSON_bool recurse) {
+    if (!item) return 0;
+    if (recurse) return lazy_complete(item) && materialize_children(item);
+    return lazy_ready(item);
+}
+
+#ifndef CJSON_SAX_STACK
+#define CJSON_SAX_STACK 64      // SAX 解析时栈上容器栈的深度，更深时转到堆上
+#endif
+
+/* SAX 解析的容器栈：每层记录该容器的结束符 '}' 或 ']' */
+typedef struct {
+    char *items;
+    size_t depth;
+    size_t capacity;
+    cJSON_bool heap;        // items 是否已转到堆上
+} saxstack;
+
+static cJSON_bool sax_push(saxstack *st, char closer) {
+    char *items;
+    if (st->depth == st->capacity) {
+        if (!(items = (char *) cJSON_malloc(st->capacity * 2))) return 0;
+        memcpy(items, st->items, st->depth);
+        if (st->heap) cJSON_free(st->items);
+        st->items = items;
+        st->capacity *= 2;
+        st->heap = 1;
+    }
+    st->items[st->depth++] = closer;
+    return 1;
+}
+
+/* 发出容器开始或结束事件，回调为空时视为继续 */
+static cJSON_bool sax_container(const cJSON_SaxHandler *h, char token, void *ctx) {
+    cJSON_bool (*fn)(void *) = token == '{' ? h->start_object : token == '}' ? h->end_object
+                             : token == '[' ? h->start_array : h->end_array;
+    return !fn || fn(ctx);
+}
+
+/* 流式解析的语法状态：下一个非空白字符应当是什么 */
+enum {
+    STREAM_VALUE,           // 一个值
+    STREAM_FIRST_VALUE,     // 刚读到 '['：一个值或 ']'
+    STREAM_KEY,             // 一个键
+    STREAM_FIRST_KEY,       // 刚读到 '{'：一个键或 '}'
+    STREAM_COLON,           // 键之后的 ':'
+    STREAM_AFTER_VALUE,     // ',' 或当前容器的结束符
+    STREAM_DONE             // 根值已结束，之后只允许空白
+};
+
+/* 流式解析状态：语法状态和容器栈之外，只保存跨块的那一个记号 */
+struct cJSON_Stream {
+    const cJSON_SaxHandler *handler;
+    void *ctx;
+    parsestate s;               // SAX 模式的解析状态，s.end 指向当前块的末尾
+    saxstack st;                // 容器栈
+    char items[CJSON_SAX_STACK];
+    int state;
+    int status;                 // 已结束时为最终结果，否则为 cJSON_ParseNeedMore
+    char *pending;              // 跨块的记号（字符串、数字或字面量）已收到的部分
+    size_t pending_length;
+    size_t pending_size;
+    char pending_kind;          // '"'、'0' 或 'a'，0 表示没有跨块的记号
+    cJSON_bool pending_escape;  // 跨块的字符串停在了反斜杠之后
+    cJSON_bool failed;          // 建树时内存不足
+    cJSON *root;                // 以下用于建树模式：结果、打开的容器、等待值的键
+    cJSON **parents;
+    size_t parents_depth;
+    size_t parents_capacity;
+    char *key;
+};
+
+/* 以下为建树模式：用 SAX 事件建立 cJSON 树，回调的 ctx 是 cJSON_Stream 本身 */
+static cJSON *tree_item(int type) {
+    cJSON *item = cJSON_New_Item();
+    if (item) item->type = type | cJSON_StringIsPooled;
+    return item;
+}
+
+/* 把新值挂到当前打开的容器上（对象成员取走等待中的键），没有打开的容器时作为根 */
+static cJSON_bool tree_add(cJSON_Stream *stream, cJSON *item) {
+    cJSON *parent;
+    if (!item) {
+        stream->failed = 1;
+        return 0;
+    }
+    if (!stream->parents_depth) {
+        stream->root = item;
+        return 1;
+    }
+    parent = stream->parents[stream->parents_depth - 1];
+    if (parent->type & cJSON_Object) {
+        item->string = stream->key;
+        item->keyhash = key_hash(item->string);
+        stream->key = NULL;
+    }
+    cJSON_AddItemToArray(parent, item);
+    return 1;
+}
+
+static cJSON_bool tree_open(cJSON_Stream *stream, int type) {
+    cJSON *item = tree_item(type);
+    cJSON **parents;
+    size_t capacity;
+    if (!tree_add(stream, item)) return 0;
+    if (stream->parents_depth == stream->parents_capacity) {
+        capacity = stream->parents_capacity ? stream->parents_capacity * 2 : 16;
+        if (!(parents = (cJSON **) cJSON_malloc(capacity * sizeof(cJSON *)))) {
+            stream->failed = 1;
+            return 0;
+        }
+        if (stream->parents_depth) memcpy(parents, stream->parents, stream->parents_depth * sizeof(cJSON *));
+        cJSON_free(stream->parents);
+        stream->parents = parents;
+        stream->parents_capacity = capacity;
+    }
+    stream->parents[stream->parents_depth++] = item;
+    return 1;
+}
+
+/* 复制 length 字节并补上 \0 */
+static char *tree_strndup(const char *str, size_t length) {
+    char *copy = string_alloc(length + 1);
+    if (!copy) return NULL;
+    memcpy(copy, str, length);
+    copy[length] = 0;
+    return copy;
+}
+
+static cJSON_bool tree_null(void *ctx) {
+    return tree_add((cJSON_Stream *) ctx, tree_item(cJSON_NULL));
+}
+
+static cJSON_bool tree_boolean(cJSON_bool value, void *ctx) {
+    cJSON *item = tree_item(value ? cJSON_True : cJSON_False);
+    if (item) item->valueint = value ? 1 : 0;
+    return tree_add((cJSON_Stream *) ctx, item);
+}
+
+static cJSON_bool tree_number(double value, void *ctx) {
+    cJSON *item = tree_item(0);
+    if (item) set_number(item, value);
+    return tree_add((cJSON_Stream *) ctx, item);
+}
+
+/* 建树时整数由 stream_scalar 直接送到这里，不经过 double */
+static cJSON_bool tree_int64(long long value, void *ctx) {
+    cJSON *item = tree_item(0);
+    if (item) set_int64(item, value);
+    return tree_add((cJSON_Stream *) ctx, item);
+}
+
+static cJSON_bool tree_string(const char *str, size_t length, void *ctx) {
+    cJSON *item = tree_item(cJSON_String);
+    if (item && !(item->valuestring = tree_strndup(str, length))) {
+        cJSON_Delete(item);
+        item = NULL;
+    }
+    return tree_add((cJSON_Stream *) ctx, item);
+}
+
+static cJSON_bool tree_key(const char *str, size_t length, void *ctx) {
+    cJSON_Stream *stream = (cJSON_Stream *) ctx;
+    cJSON_free(stream->key);
+    if (!(stream->key = tree_strndup(str, length))) stream->failed = 1;
+    return stream->key != NULL;
+}
+
+static cJSON_bool tree_start_object(void *ctx) {
+    return tree_open((cJSON_Stream *) ctx, cJSON_Object);
+}
+
+static cJSON_bool tree_start_array(void *ctx) {
+    return tree_open((cJSON_Stream *) ctx, cJSON_Array);
+}
+
+static cJSON_bool tree_close(void *ctx) {
+    ((cJSON_Stream *) ctx)->parents_depth--;
+    return 1;
+}
+
+static const cJSON_SaxHandler tree_handler = {tree_null, tree_boolean, tree_number, tree_string, tree_start_object,
+                                              tree_key, tree_close, tree_start_array, tree_close};
+
+/* 记号的种类：字符串 '"'、数字 '0'、字面量 'a'，不是记号的开头时返回 0 */
+static char token_kind(char c) {
+    if (c == '\"') return '\"';
+    if (c == '-' || (c >= '0' && c <= '9')) return '0';
+    if (c >= 'a' && c <= 'z') return 'a';
+    return 0;
+}
+
+/**
+ * @brief 找到记号的结尾
+ *
+ * @param kind 记号的种类
+ * @param p 开始查找的位置（字符串从开头引号之后开始）
+ * @param end 当前块的末尾
+ * @param escape 输入输出：字符串在 p 之前停在了反斜杠之后
+ * @return const char* 返回记号之后的位置；到 end 仍未结束时返回 NULL
+ */
+static const char *token_end(char kind, const char *p, const char *end, cJSON_bool *escape) {
+    if (kind == '\"') {
+        if (*escape) {
+            if (p >= end) return NULL;
+            p++;
+            *escape = 0;
+        }
+        for (;;) {
+            p = scan_string(p, end);
+            if (p >= end) return NULL;
+            if (*p != '\\') return p + 1;   // 结束引号，或交给 parse_string_view 报错的 \0
+            if (p + 1 >= end) {
+                *escape = 1;
+                return NULL;
+            }
+            p += 2;
+        }
+    }
+    if (kind == 'a') while (p < end && *p >= 'a' && *p <= 'z') p++;
+    else while (p < end && ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E')) p++;
+    return p < end ? p : NULL;
+}
+
+/* 回调返回假：建树时内存不足算作出错，否则是调用者主动中止 */
+static int stream_stop(cJSON_Stream *stream) {
+    return stream->status = stream->failed ? cJSON_ParseError : cJSON_ParseStopped;
+}
+
+static int stream_error(cJSON_Stream *stream, const char *at) {
+    ep = at;
+    return stream->status = cJSON_ParseError;
+}
+
+/**
+ * @brief 在 [value, s.end) 内直接解析并送出一个记号（字符串、数字或字面量）
+ *
+ * 扫描函数本身以 s.end 为界：记号若在 s.end 之前结束就一次完成，不再另外查找记号的结尾。
+ *
+ * @param stream 流式解析状态
+ * @param value 记号开头
+ * @param key 为真时字符串作为键送出
+ * @param last 为真时 s.end 就是输入的末尾，记号不会再有后续
+ * @param status 失败时输出结果；记号被 s.end 截断时为 cJSON_ParseNeedMore
+ * @return const char* 成功时返回记号之后的位置，失败或被截断时返回 NULL
+ */
+static const char *stream_scalar(cJSON_Stream *stream, const char *value, cJSON_bool key, cJSON_bool last,
+                                 int *status) {
+    const cJSON_SaxHandler *h = stream->handler;
+    const char *end = stream->s.end, *p;
+    cJSON_bool ok, escape = 0, is_int64 = 0;
+    long long integer = 0;
+    char *str;
+    size_t len;
+    double n;
+
+    *status = cJSON_ParseNeedMore;
+    if (*value == '\"') {
+        if (!(p = parse_string_view(value, &stream->s, &str, &len))) {
+            if (!last && (ep == end || (ep + 1 == end && *ep == '\\'))) return NULL;  // 没找到结束引号：等下一块
+            *status = stream->status = cJSON_ParseError;
+            return NULL;
+        }
+        ok = key ? !h->key || h->key(str, len, stream->ctx) : !h->string || h->string(str, len, stream->ctx);
+    } else if (*value == '-' || (*value >= '0' && *value <= '9')) {
+        p = parse_number_value(value, &stream->s, &n, &is_int64, &integer);
+        if (!last && !token_end('0', p, end, &escape)) return NULL;    // 数字可能还没结束，如块停在 "1." 或 "1e" 之后
+        if (h == &tree_handler && is_int64) ok = tree_int64(integer, stream->ctx);     // SAX 回调只有 double
+        else ok = !h->number || h->number(n, stream->ctx);
+    } else if (end - value >= 4 && !memcmp(value, "null", 4)) {
+        p = value + 4;
+        ok = !h->null_value || h->null_value(stream->ctx);
+    } else if (end - value >= 4 && !memcmp(value, "true", 4)) {
+        p = value + 4;
+        ok = !h->boolean || h->boolean(1, stream->ctx);
+    } else if (end - value >= 5 && !memcmp(value, "false", 5)) {
+        p = value + 5;
+        ok = !h->boolean || h->boolean(0, stream->ctx);
+    } else {
+        for (p = value; p < end && *p >= 'a' && *p <= 'z'; p++);
+        if (p == end && end - value < 5 && !last) return NULL;  // 可能是被截断的字面量
+        *status = stream_error(stream, value);
         return NULL;
-    } // 非法输入
+    }
+
+    if (!ok) {
+        *status = stream_stop(stream);
+        return NULL;
+    }
+    return p;
+}
+
+/* 把 [data, data + length) 追加到跨块的记号 */
+static cJSON_bool stream_pending_append(cJSON_Stream *stream, const char *data, size_t length) {
+    size_t newsize;
+    char *buffer;
+    if (stream->pending_length + length > stream->pending_size) {
+        for (newsize = stream->pending_size ? stream->pending_size : 64; newsize < stream->pending_length + length;)
+            newsize *= 2;
+        if (!(buffer = (char *) cJSON_malloc(newsize))) return 0;
+        if (stream->pending_length) memcpy(buffer, stream->pending, stream->pending_length);
+        cJSON_free(stream->pending);
+        stream->pending = buffer;
+        stream->pending_size = newsize;
+    }
+    memcpy(stream->pending + stream->pending_length, data, length);
+    stream->pending_length += length;
+    return 1;
+}
+
+/* 记号被块的末尾截断：复制已收到的部分，记下字符串是否停在反斜杠之后，等下一块补齐 */
+static int stream_suspend(cJSON_Stream *stream, const char *value, const char *end, int state) {
+    cJSON_bool escape = 0;
+    char kind = token_kind(*value);
+    if (kind == '\"') token_end(kind, value + 1, end, &escape);
+    if (!stream_pending_append(stream, value, end - value)) return stream->status = cJSON_ParseError;
+    stream->pending_kind = kind;
+    stream->pending_escape = escape;
+    stream->state = state;
+    ep = NULL;
+    return cJSON_ParseNeedMore;
+}
+
+/**
+ * @brief 流式解析的主循环：消费 [value, end)，可在任意字节处暂停
+ *
+ * 用显式的容器栈和语法状态代替递归。语法状态只在进入时分派一次，之后键、冒号、值和分隔符
+ * 顺序执行，每个成员只分派一次。完整落在块内的记号直接从块中解析；被块的末尾截断的记号
+ * 先复制到 pending，下一块补齐后再整体解析，因此暂停点可以在字符串、\u 转义或数字的中间。
+ *
+ * @param stream 流式解析状态
+ * @param value 当前块
+ * @param end 当前块的末尾
+ * @param last 为真时这是最后一块，末尾的数字或字面量就此结束
+ * @return int cJSON_ParseNeedMore、cJSON_ParseDone、cJSON_ParseStopped 或 cJSON_ParseError
+ */
+static int stream_run(cJSON_Stream *stream, const char *value, const char *end, cJSON_bool last) {
+    parsestate *s = &stream->s;
+    saxstack *st = &stream->st;
+    const char *p;
+    cJSON_bool key;
+    char token;
+    int status, state = stream->state;     // 语法状态放在局部变量里，只在暂停时写回
+
+    if (stream->status != cJSON_ParseNeedMore && stream->status != cJSON_ParseDone) return stream->status;
+    s->end = end;
+
+    if (stream->pending_kind) {     // 先补齐上一块末尾被截断的记号，补齐后整体解析
+        p = token_end(stream->pending_kind, value, end, &stream->pending_escape);
+        if (!p && !last) {
+            if (!stream_pending_append(stream, value, end - value)) return stream->status = cJSON_ParseError;
+            return cJSON_ParseNeedMore;
+        }
+        if (!p) p = end;
+        if (!stream_pending_append(stream, value, p - value)) return stream->status = cJSON_ParseError;
+        key = state == STREAM_KEY;
+        stream->pending_kind = 0;
+        s->end = stream->pending + stream->pending_length;
+        value = stream_scalar(stream, stream->pending, key, 1, &status);
+        if (value && value != s->end) return stream_error(stream, value);  // 记号之后还有残余，如 1.2.3
+        if (!value) return status;
+        s->end = end;
+        stream->pending_length = 0;
+        state = key ? STREAM_COLON : STREAM_AFTER_VALUE;
+        value = p;
+    }
+
+    for (;;) {
+        switch (state) {
+            case STREAM_FIRST_KEY:
+            case STREAM_KEY:
+                value = skip(value, s);
+                if (value >= end || (*value == '}' && state == STREAM_FIRST_KEY)) break;   // 暂停或空对象
+                if (*value != '\"') return stream_error(stream, value);
+                if (!(p = stream_scalar(stream, value, 1, last, &status))) {
+                    if (status != cJSON_ParseNeedMore) return status;
+                    return stream_suspend(stream, value, end, STREAM_KEY);
+                }
+                value = p;
+                state = STREAM_COLON;
+                [[fallthrough]];
+            case STREAM_COLON:
+                value = skip(value, s);
+                if (value >= end) break;
+                if (*value != ':') return stream_error(stream, value);
+                value++;
+                state = STREAM_VALUE;
+                [[fallthrough]];
+            case STREAM_FIRST_VALUE:
+            case STREAM_VALUE:
+                value = skip(value, s);
+                if (value >= end || (*value == ']' && state == STREAM_FIRST_VALUE)) break;  // 暂停或空数组
+                token = *value;
+                if (token == '{' || token == '[') {     // 打开容器，内容留给下一轮
+                    if (!sax_container(stream->handler, token, stream->ctx)) return stream_stop(stream);
+                    if (!sax_push(st, token == '{' ? '}' : ']')) return stream->status = cJSON_ParseError;
+                    state = token == '{' ? STREAM_FIRST_KEY : STREAM_FIRST_VALUE;
+                    value++;
+                    continue;
+                }
+                if (!token_kind(token)) return stream_error(stream, value);
+                if (!(p = stream_scalar(stream, value, 0, last, &status))) {
+                    if (status != cJSON_ParseNeedMore) return status;
+                    return stream_suspend(stream, value, end, STREAM_VALUE);
+                }
+                value = p;
+                state = STREAM_AFTER_VALUE;
+                [[fallthrough]];
+            case STREAM_AFTER_VALUE:
+                if (!st->depth) {
+                    state = STREAM_DONE;
+                    continue;
+                }
+                value = skip(value, s);
+                if (value >= end) break;
+                if (*value == ',') {
+                    state = st->items[st->depth - 1] == '}' ? STREAM_KEY : STREAM_VALUE;
+                    value++;
+                    continue;
+                }
+                if (*value != st->items[st->depth - 1]) return stream_error(stream, value);
+                break;              // 关闭当前容器
+            default:                // STREAM_DONE：根值之后只允许空白
+                value = skip(value, s);
+                if (value >= end) break;
+                return stream_error(stream, value);
+        }
+
+        if (value >= end) {         // 当前块已全部消费
+            stream->state = state;
+            if (state == STREAM_DONE) return stream->status = cJSON_ParseDone;
+            if (last) return stream_error(stream, value);
+            return cJSON_ParseNeedMore;
+        }
+        token = *value;             // 关闭当前容器
+        st->depth--;
+        if (!sax_container(stream->handler, token, stream->ctx)) return stream_stop(stream);
+        state = STREAM_AFTER_VALUE;
+        value++;
+    }
+}
+
+/* 初始化流式解析状态，handler 为 NULL 时建立 cJSON 树 */
+static void stream_init(cJSON_Stream *stream, const cJSON_SaxHandler *handler, void *ctx) {
+    memset(stream, 0, sizeof(*stream));
+    stream->handler = handler ? handler : &tree_handler;
+    stream->ctx = handler ? ctx : stream;
+    stream->s.borrow = 1;
+    stream->st.items = stream->items;
+    stream->st.capacity = sizeof(stream->items);
+    stream->state = STREAM_VALUE;
+    stream->status = cJSON_ParseNeedMore;
+}
+
+/* 释放流式解析状态持有的内存（不含 stream 本身） */
+static void stream_free(cJSON_Stream *stream) {
+    if (stream->st.heap) cJSON_free(stream->st.items);
+    cJSON_free(stream->s.scratch);
+    cJSON_free(stream->pending);
+    cJSON_free(stream->parents);
+    cJSON_free(stream->key);
+    cJSON_Delete(stream->root);
+}
+
+/**
+ * @brief 以 SAX 方式解析 JSON 文本：按顺序调用 handler 中的回调，不建立 cJSON 树
+ *
+ * 不含转义的键和字符串直接指向输入，含转义的反转义到一块复用的缓冲区中，
+ * 因此除了这块缓冲区和超过 CJSON_SAX_STACK 层时的容器栈之外不分配内存。
+ *
+ * @param value 指向 JSON 文本的指针，不需要以 \0 结尾
+ * @param length 文本长度
+ * @param handler 回调，为空的回调直接跳过
+ * @param ctx 传给回调的用户数据
+ * @return int 解析完成返回 cJSON_ParseDone，回调返回假时返回 cJSON_ParseStopped，出错返回 cJSON_ParseError
+ */
+int cJSON_ParseSax(const char *value, size_t length, const cJSON_SaxHandler *handler, void *ctx) {
+    cJSON_Stream stream;
+    int status;
+    ep = NULL;
+    if (!value || !handler) return cJSON_ParseError;
+    stream_init(&stream, handler, ctx);
+    status = stream_run(&stream, value, value + length, 1);
+    stream_free(&stream);
+    return status;
+}
+
+cJSON_Stream *cJSON_CreateStream(const cJSON_SaxHandler *handler, void *ctx) {
+    cJSON_Stream *stream = (cJSON_Stream *) cJSON_malloc(sizeof(cJSON_Stream));
+    if (stream) stream_init(stream, handler, ctx);
+    return stream;
+}
+
+int cJSON_StreamFeed(cJSON_Stream *stream, const char *chunk, size_t length) {
+    ep = NULL;
+    if (!stream || (!chunk && length)) return cJSON_ParseError;
+    return stream_run(stream, chunk, chunk + length, 0);
+}
+
+int cJSON_StreamFinish(cJSON_Stream *stream) {
+    static const char empty[1] = "";
+    ep = NULL;
+    if (!stream) return cJSON_ParseError;
+    return stream_run(stream, empty, empty, 1);
+}
+
+cJSON *cJSON_StreamDetachTree(cJSON_Stream *stream) {
+    cJSON *root;
+    if (!stream || stream->status != cJSON_ParseDone) return NULL;
+    root = stream->root;
+    stream->root = NULL;
+    return root;
+}
+
+void cJSON_DeleteStream(cJSON_Stream *stream) {
+    if (!stream) return;
+    stream_free(stream);
+    cJSON_free(stream);
+}
+
+/*
+ * NDJSON 并行解析
+ * 输入按 CJSON_NDJSON_BATCH 字节切成批，批的边界移到其后第一个换行之后，因此每条记录完整地落在一个批内，
+ * 各批的边界可以独立算出。工作线程用原子计数器领取批，每个线程有自己的 arena，解析时互不加锁。
+ */
+#define CJSON_NDJSON_BATCH (1 << 20)
+
+typedef struct {
+    cJSON *item;
+    size_t offset;              // 记录在输入中的字节偏移
+} ndjson_record;
+
+struct ndjson_job {
+    const char *value, *end;    // 整个输入
+    size_t batches;             // 批的个数
+    cJSON_bool ordered;
+    cJSON_RecordHandler handler;
+    void *ctx;
+    std::atomic<size_t> next;   // 下一个待领取的批
+    std::atomic<int> status;    // cJSON_ParseDone，或第一次失败的结果
+    const char *error;          // 第一次失败的出错位置
+    std::mutex lock;
+    std::condition_variable turn_changed;
+    size_t turn;                // 有序模式下轮到交付的批
+};
+
+/* 第 batch 批的起始位置：第 batch 个 CJSON_NDJSON_BATCH 字节处所在行的下一行 */
+static const char *ndjson_boundary(const ndjson_job *job, size_t batch) {
+    const char *at, *nl;
+    if (!batch) return job->value;
+    if (batch * CJSON_NDJSON_BATCH >= (size_t) (job->end - job->value)) return job->end;
+    at = job->value + batch * CJSON_NDJSON_BATCH - 1;   // 恰好从边界开始的行也归入这一批
+    nl = (const char *) memchr(at, '\n', job->end - at);
+    return nl ? nl + 1 : job->end;
+}
+
+/* 记录第一次失败，并唤醒等待交付的线程让它们退出 */
+static void ndjson_fail(ndjson_job *job, int status, const char *error) {
+    {
+        std::lock_guard<std::mutex> guard(job->lock);
+        if (job->status != cJSON_ParseDone) return;
+        job->status = status;
+        job->error = error;
+    }
+    job->turn_changed.notify_all();
+}
+
+/* 有序模式：等轮到第 batch 批时依次交付它的记录，status 和 error 是这一批的解析结果，失败在让出轮次之前记录 */
+static void ndjson_deliver(ndjson_job *job, size_t batch, const ndjson_record *records, size_t count, int status,
+                           const char *error) {
+    std::unique_lock<std::mutex> guard(job->lock);
+    job->turn_changed.wait(guard, [&] { return job->turn == batch || job->status != cJSON_ParseDone; });
+    if (job->status != cJSON_ParseDone) return;     // 之前的批已经失败，不再交付
+    guard.unlock();                 // 交付期间不持锁，轮次本身保证回调不会并发
+    for (size_t i = 0; i < count; i++) {
+        if (!job->handler(records[i].item, records[i].offset, job->ctx)) {
+            status = cJSON_ParseStopped;
+            error = NULL;
+            break;
+        }
+    }
+    guard.lock();
+    if (status != cJSON_ParseDone) {
+        job->status = status;
+        job->error = error;
+    }
+    job->turn++;
+    guard.unlock();
+    job->turn_changed.notify_all();
+}
+
+/* 工作线程：反复领取一批，逐行解析到自己的 arena 中，无序模式解析完一条就回调，有序模式整批按轮次交付 */
+static void ndjson_worker(ndjson_job *job) {
+    cJSON_Arena *arena = cJSON_CreateArena(0);
+    ndjson_record *records = NULL, *grown;
+    size_t count, capacity = 0, batch;
+
+    if (!arena) {
+        ndjson_fail(job, cJSON_ParseError, NULL);
+        return;
+    }
+    while (job->status == cJSON_ParseDone && (batch = job->next++) < job->batches) {
+        const char *line = ndjson_boundary(job, batch), *end = ndjson_boundary(job, batch + 1), *nl;
+        const char *error = NULL;
+        int status = cJSON_ParseDone;
+
+        count = 0;
+        while (line < end && job->status.load(std::memory_order_relaxed) == cJSON_ParseDone) {
+            parsestate s = {};
+            cJSON *item;
+
+            s.arena = arena;
+            nl = (const char *) memchr(line, '\n', end - line);
+            if (!nl) nl = end;
+            if (skip_whitespace(line, nl) == nl) {   // 空行
+                line = nl < end ? nl + 1 : end;
+                continue;
+            }
+            if (!(item = parse_root(line, nl - line, NULL, 1, &s))) {
+                status = cJSON_ParseError;
+                error = ep;
+                break;
+            }
+            if (!job->ordered) {
+                if (!job->handler(item, line - job->value, job->ctx)) {
+                    status = cJSON_ParseStopped;
+                    break;
+                }
+                cJSON_ResetArena(arena);
+            } else {
+                if (count == capacity) {
+                    capacity = capacity ? capacity * 2 : 256;
+                    if (!(grown = (ndjson_record *) cJSON_malloc(capacity * sizeof(ndjson_record)))) {
+                        status = cJSON_ParseError;
+                        break;
+                    }
+                    if (count) memcpy(grown, records, count * sizeof(ndjson_record));
+                    cJSON_free(records);
+                    records = grown;
+                }
+                records[count].item = item;
+                records[count++].offset = line - job->value;
+            }
+            line = nl < end ? nl + 1 : end;
+        }
+        if (job->ordered) ndjson_deliver(job, batch, records, count, status, error);   // 出错的批也先交付出错之前的记录
+        else if (status != cJSON_ParseDone) ndjson_fail(job, status, error);
+        cJSON_ResetArena(arena);
+    }
+    cJSON_free(records);
+    cJSON_DeleteArena(arena);
+}
+
+int cJSON_ParseNdjson(const char *value, size_t length, int threads, cJSON_bool ordered, cJSON_RecordHandler handler,
+                      void *ctx) {
+    ndjson_job job;
+    std::vector<std::thread> workers;
+
+    ep = NULL;
+    if (!value || !handler) return cJSON_ParseError;
+    job.value = value;
+    job.end = value + length;
+    job.batches = (length + CJSON_NDJSON_BATCH - 1) / CJSON_NDJSON_BATCH;
+    job.ordered = ordered;
+    job.handler = handler;
+    job.ctx = ctx;
+    job.next = 0;
+    job.status = cJSON_ParseDone;
+    job.error = NULL;
+    job.turn = 0;
+
+    if (threads <= 0) threads = (int) std::thread::hardware_concurrency();
+    if ((size_t) threads > job.batches) threads = (int) job.batches;
+    try {                       // 线程创建失败时用已有的线程继续
+        workers.reserve(threads > 1 ? threads - 1 : 0);
+        for (int i = 1; i < threads; i++) workers.emplace_back(ndjson_worker, &job);
+    } catch (...) {}
+    ndjson_worker(&job);        // 调用线程也是一个工作线程
+    for (std::thread &worker: workers) worker.join();
+
+    ep = job.error;
+    return job.status;
+}
+
+/*
+ * 紧凑文档
+ * 所有节点按解析顺序（先序）连续存放在一个数组里，每个节点 16 字节：子节点紧跟在容器之后，
+ * 对象成员的键是值之前的一个节点。容器记录子树之后第一个节点的下标，遍历兄弟时可以跳过整棵子树；
+ * 每个容器的最后一个子节点带 DOC_LAST 标记。不超过 7 字节的字符串和键内联在节点中，
+ * 更长的存放在字符池里，都以 \0 结尾。
+ */
+#define DOC_KEY 1               // 对象成员的键
+#define DOC_LAST 2              // 所在容器的最后一个子节点
+#define DOC_INLINE_MAX 7        // 内联字符串的最大长度（不含 \0）
+
+typedef struct {
+    unsigned char type;         // cJSON_False ... cJSON_Object
+    unsigned char flags;        // DOC_KEY、DOC_LAST
+    unsigned length;            // 字符串的长度，容器的子节点数
+    union {
+        double number;
+        unsigned long long offset;  // 长字符串在字符池中的偏移
+        char bytes[8];          // 短字符串
+        size_t end;             // 容器：子树之后第一个节点的下标
+    } u;
+} doc_node;
+
+typedef struct {
+    size_t node;                // 容器节点的下标
+    size_t last;                // 容器中最后一个子节点的下标
+} doc_level;
+
+struct cJSON_Doc {
+    doc_node *nodes;
+    size_t count, capacity;
+    char *chars;                // 字符池
+    size_t chars_used, chars_size;
+    doc_level *levels;          // 解析时打开的容器，解析完成后释放
+    size_t depth, levels_capacity;
+};
+
+/* 按 2 的幂扩容 *buffer，保证至少能再放下 need 个 unit 字节的元素 */
+static cJSON_bool doc_reserve(void **buffer, size_t *capacity, size_t used, size_t need, size_t unit) {
+    size_t newcapacity;
+    void *grown;
+    if (used + need <= *capacity) return 1;
+    for (newcapacity = *capacity ? *capacity : 64; newcapacity < used + need;) newcapacity *= 2;
+    if (!(grown = cJSON_malloc(newcapacity * unit))) return 0;
+    if (used) memcpy(grown, *buffer, used * unit);
+    cJSON_free(*buffer);
+    *buffer = grown;
+    *capacity = newcapacity;
+    return 1;
+}
+
+/* 追加一个节点，并把它记为当前容器的最后一个子节点 */
+static doc_node *doc_add(cJSON_Doc *doc, int type, unsigned char flags) {
+    doc_node *node;
+    if (!doc_reserve((void **) &doc->nodes, &doc->capacity, doc->count, 1, sizeof(doc_node))) return NULL;
+    node = &doc->nodes[doc->count];
+    node->type = (unsigned char) type;
+    node->flags = flags;
+    node->length = 0;
+    node->u.offset = 0;
+    if (doc->depth && !(flags & DOC_KEY)) {
+        doc->levels[doc->depth - 1].last = doc->count;
+        doc->nodes[doc->levels[doc->depth - 1].node].length++;
+    }
+    doc->count++;
+    return node;
+}
+
+static cJSON_bool doc_add_string(cJSON_Doc *doc, const char *str, size_t length, unsigned char flags) {
+    doc_node *node;
+    if (length > UINT_MAX || !(node = doc_add(doc, cJSON_String, flags))) return 0;
+    node->length = (unsigned) length;
+    if (length <= DOC_INLINE_MAX) {
+        memcpy(node->u.bytes, str, length);
+        node->u.bytes[length] = 0;
+        return 1;
+    }
+    if (!doc_reserve((void **) &doc->chars, &doc->chars_size, doc->chars_used, length + 1, 1)) return 0;
+    node->u.offset = doc->chars_used;
+    memcpy(doc->chars + doc->chars_used, str, length);
+    doc->chars[doc->chars_used + length] = 0;
+    doc->chars_used += length + 1;
+    return 1;
+}
+
+static cJSON_bool doc_null(void *ctx) {
+    return doc_add((cJSON_Doc *) ctx, cJSON_NULL, 0) != NULL;
+}
+
+static cJSON_bool doc_boolean(cJSON_bool value, void *ctx) {
+    return doc_add((cJSON_Doc *) ctx, value ? cJSON_True : cJSON_False, 0) != NULL;
+}
+
+static cJSON_bool doc_number(double value, void *ctx) {
+    doc_node *node = doc_add((cJSON_Doc *) ctx, cJSON_Number, 0);
+    if (node) node->u.number = value;
+    return node != NULL;
+}
 
-    item->type = cJSON_Array;
-    value = skip(value + 1);
-    if (*value == ']') return value + 1; // 空数组
+static cJSON_bool doc_string(const char *str, size_t length, void *ctx) {
+    return doc_add_string((cJSON_Doc *) ctx, str, length, 0);
+}
 
-    item->child = child = cJSON_New_Item();
-    if (!item->child) return NULL; // 内存分配失败
+static cJSON_bool doc_key(const char *str, size_t length, void *ctx) {
+    return doc_add_string((cJSON_Doc *) ctx, str, length, DOC_KEY);
+}
 
-    value = skip(parse_value(child, skip(value)));
-    if (!value) return NULL; // 解析失败
+static cJSON_bool doc_open(cJSON_Doc *doc, int type) {
+    if (!doc_add(doc, type, 0)) return 0;
+    if (!doc_reserve((void **) &doc->levels, &doc->levels_capacity, doc->depth, 1, sizeof(doc_level))) return 0;
+    doc->levels[doc->depth].node = doc->count - 1;
+    doc->levels[doc->depth++].last = 0;
+    return 1;
+}
 
-    while (*value == ',') {
-        cJSON *new_item;
-        if (!(new_item = cJSON_New_Item())) return NULL; // 内存分配失败
-        child->next = new_item, new_item->prev = child, child = new_item;
-        value = skip(parse_value(child, skip(value + 1)));
-        if (!value) return NULL; // 解析失败
-    }
+static cJSON_bool doc_close(void *ctx) {
+    cJSON_Doc *doc = (cJSON_Doc *) ctx;
+    doc_level *level = &doc->levels[--doc->depth];
+    doc->nodes[level->node].u.end = doc->count;
+    if (doc->nodes[level->node].length) doc->nodes[level->last].flags |= DOC_LAST;
+    return 1;
+}
 
-    if (*value == ']') return value + 1; // 解析成功
-    ep = value;
-    return NULL; // 解析失败
+static cJSON_bool doc_start_object(void *ctx) {
+    return doc_open((cJSON_Doc *) ctx, cJSON_Object);
 }
 
-/**
- * @brief 解析 JSON 对象
- *
- * @param item cJSON 对象
- * @param value 指向 JSON 字符串的指针
- * @return const char* 成功时返回下一个要解析的位置，失败时返回 NULL
- */static const char *parse_object(cJSON *item, const char *value) {
-    cJSON *child;
-    if (*value != '{') {
-        ep = value;
-        return NULL;
-    } // 非法输入
+static cJSON_bool doc_start_array(void *ctx) {
+    return doc_open((cJSON_Doc *) ctx, cJSON_Array);
+}
 
-    item->type = cJSON_Object;
-    value = skip(value + 1);
-    if (*value == '}') return value + 1; // 空对象
+static const cJSON_SaxHandler doc_handler = {doc_null, doc_boolean, doc_number, doc_string, doc_start_object,
+                                             doc_key, doc_close, doc_start_array, doc_close};
 
-    item->child = child = cJSON_New_Item();
-    if (!item->child) return NULL; // 内存分配失败
+/*
+ * 节点数的上界：根值之外，每个键前面有一个 { 或 ,，对象成员的值前面有一个 :，
+ * 数组元素前面有一个 [ 或 ,。字符串里的这些字符只会让上界偏大
+ */
+static size_t doc_count_nodes(const char *value, size_t length) {
+    const unsigned char *p = (const unsigned char *) value;
+    size_t n = 1;
+    for (size_t i = 0; i < length; i++) n += (p[i] == ',') | (p[i] == ':') | (p[i] == '[') | (p[i] == '{');
+    return n;
+}
 
-    value = skip(parse_string(child, skip(value)));
-    if (!value) return NULL; // 解析失败
+cJSON_Doc *cJSON_ParseDoc(const char *value, size_t length) {
+    cJSON_Doc *doc = (cJSON_Doc *) cJSON_malloc(sizeof(cJSON_Doc));
+    int status;
+    if (!doc) return NULL;
+    memset(doc, 0, sizeof(cJSON_Doc));
+    /* 节点数组按数出的上界一次分配，解析中不再搬移；字符池的大小无法预先估计，按 2 的幂扩容 */
+    doc->capacity = value ? doc_count_nodes(value, length) : 1;
+    if (!(doc->nodes = (doc_node *) cJSON_malloc(doc->capacity * sizeof(doc_node)))) {
+        ep = NULL;
+        cJSON_free(doc);
+        return NULL;
+    }
+    status = cJSON_ParseSax(value, length, &doc_handler, doc);
+    cJSON_free(doc->levels);
+    doc->levels = NULL;
+    if (status != cJSON_ParseDone) {
+        if (status == cJSON_ParseStopped) ep = NULL;    // 内存不足
+        cJSON_DeleteDoc(doc);
+        return NULL;
+    }
+    return doc;
+}
 
-    child->string = child->valuestring;
-    child->valuestring = NULL;
+void cJSON_DeleteDoc(cJSON_Doc *doc) {
+    if (!doc) return;
+    cJSON_free(doc->nodes);
+    cJSON_free(doc->chars);
+    cJSON_free(doc->levels);
+    cJSON_free(doc);
+}
 
-    if (*value != ':') {
-        ep = value;
-        return NULL;
-    } // 非法输入
+/* 检查下标是否有效，键节点不是值 */
+static const doc_node *doc_value(const cJSON_Doc *doc, size_t ref) {
+    return doc && ref < doc->count && !(doc->nodes[ref].flags & DOC_KEY) ? &doc->nodes[ref] : NULL;
+}
 
-    value = skip(parse_value(child, skip(value + 1)));
-    if (!value) return NULL; // 解析失败
+static const char *doc_chars(const cJSON_Doc *doc, const doc_node *node) {
+    return node->length <= DOC_INLINE_MAX ? node->u.bytes : doc->chars + node->u.offset;
+}
 
-    while (*value == ',') {
-        cJSON *new_item;
+int cJSON_DocType(const cJSON_Doc *doc, size_t ref) {
+    const doc_node *node = doc_value(doc, ref);
+    return node ? node->type : cJSON_Invalid;
+}
 
-        if (!(new_item = cJSON_New_Item())) return NULL; // 内存分配失败
+double cJSON_DocNumber(const cJSON_Doc *doc, size_t ref) {
+    const doc_node *node = doc_value(doc, ref);
+    return node && node->type == cJSON_Number ? node->u.number : 0;
+}
 
-        child->next = new_item, new_item->prev = child, child = new_item;
+const char *cJSON_DocString(const cJSON_Doc *doc, size_t ref, size_t *length) {
+    const doc_node *node = doc_value(doc, ref);
+    if (!node || node->type != cJSON_String) return NULL;
+    if (length) *length = node->length;
+    return doc_chars(doc, node);
+}
 
-        value = skip(parse_string(child, skip(value + 1)));
-        if (!value) return NULL; // 解析失败
+const char *cJSON_DocKey(const cJSON_Doc *doc, size_t ref, size_t *length) {
+    const doc_node *key;
+    if (!doc_value(doc, ref) || !ref || !(doc->nodes[ref - 1].flags & DOC_KEY)) return NULL;
+    key = &doc->nodes[ref - 1];
+    if (length) *length = key->length;
+    return doc_chars(doc, key);
+}
 
-        child->string = child->valuestring;
-        child->valuestring = NULL;
+size_t cJSON_DocSize(const cJSON_Doc *doc, size_t ref) {
+    const doc_node *node = doc_value(doc, ref);
+    return node && (node->type & (cJSON_Array | cJSON_Object)) ? node->length : 0;
+}
 
-        if (*value != ':') {
-            ep = value;
-            return NULL;
-        } // 非法输入
+size_t cJSON_DocChild(const cJSON_Doc *doc, size_t ref) {
+    const doc_node *node = doc_value(doc, ref);
+    if (!node || !(node->type & (cJSON_Array | cJSON_Object)) || !node->length) return cJSON_DocNone;
+    return node->type == cJSON_Object ? ref + 2 : ref + 1;
+}
 
-        value = skip(parse_value(child, skip(value + 1)));
-        if (!value) return NULL; // 解析失败
-    }
+size_t cJSON_DocNext(const cJSON_Doc *doc, size_t ref) {
+    const doc_node *node = doc_value(doc, ref);
+    if (!node || (node->flags & DOC_LAST) || !ref) return cJSON_DocNone;
+    ref = node->type & (cJSON_Array | cJSON_Object) ? node->u.end : ref + 1;
+    return doc->nodes[ref].flags & DOC_KEY ? ref + 1 : ref;
+}
 
-    if (*value == '}') return value + 1; // 解析成功
-    ep = value;
-    return NULL; // 解析失败
+size_t cJSON_DocGetArrayItem(const cJSON_Doc *doc, size_t ref, size_t index) {
+    if (cJSON_DocType(doc, ref) != cJSON_Array) return cJSON_DocNone;
+    for (ref = cJSON_DocChild(doc, ref); ref != cJSON_DocNone && index--;) ref = cJSON_DocNext(doc, ref);
+    return ref;
+}
+
+size_t cJSON_DocGetObjectItem(const cJSON_Doc *doc, size_t ref, const char *key) {
+    size_t length, i;
+    const char *name;
+    if (!key || cJSON_DocType(doc, ref) != cJSON_Object) return cJSON_DocNone;
+    for (ref = cJSON_DocChild(doc, ref); ref != cJSON_DocNone; ref = cJSON_DocNext(doc, ref)) {
+        if (!(name = cJSON_DocKey(doc, ref, &length))) continue;
+        for (i = 0; i < length && key[i] && ascii_lower(name[i]) == ascii_lower(key[i]); i++) {}
+        if (i == length && !key[length]) return ref;
+    }
+    return cJSON_DocNone;
 }
 
 /**
- * @brief 将 cJSON 对象转换为 JSON 字符串
+ * @brief 将 cJSON 对象转换为 JSON 字符串，追加到缓冲区
+ *
+ * 用显式的容器栈代替递归：进入容器时压栈并转去输出第一个成员，一个值输出后
+ * 输出分隔符转到下一个成员，或关闭容器回到上一层。格式与逐层递归输出完全相同。
  *
  * @param item cJSON 对象
  * @param depth 当前对象的嵌套深度
  * @param fmt 是否格式化输出
- * @param p 指向 printbuffer 的指针，用于存储转换后的字符串
- * @return char* 成功时返回转换后的字符串，失败时返回 NULL
- */static char *print_value(cJSON *item, int depth, int fmt, printbuffer *p) {
-    char *out = NULL;
-    if (!item) return NULL;
+ * @param p 指向 printbuffer 的指针
+ * @return size_t 返回写入的字节数，失败时返回 0
+ */
+static size_t print_value(const cJSON *item, int depth, cJSON_bool fmt, printbuffer *p) {
+    treestack st;
+    treeframe *frame;
+    cJSON_bool object;
+    size_t len = 0, n;
+
+    if (!item) return 0;
+    treestack_init(&st);
+    for (;;) {
+        n = 1;
+        if (st.depth && (st.frames[st.depth - 1].source->type & cJSON_Object)) {   // 对象成员先输出键
+            if (fmt) {
+                n = print_indent(p, depth);
+                len += depth;
+            }
+            if (n && (n = print_string_ptr(item->string, p))) {
+                len += n;
+                if ((n = print_raw(p, ": ", fmt ? 2 : 1))) len += n;
+            }
+            if (!n) break;
+        }
 
-    if (p) {
         switch ((item->type) & 255) {
-            case cJSON_NULL: {
-                out = ensure(p, 5);
-                if (out) strcpy(out, "null");
-                break;
-            }
-            case cJSON_False: {
-                out = ensure(p, 6);
-                if (out) strcpy(out, "false");
+            case cJSON_NULL:
+                n = print_raw(p, "null", 4);
                 break;
-            }
-            case cJSON_True: {
-                out = ensure(p, 5);
-                if (out) strcpy(out, "true");
+            case cJSON_False:
+                n = print_raw(p, "false", 5);
                 break;
-            }
-            case cJSON_Number: {
-                out = print_number(item, p);
+            case cJSON_True:
+                n = print_raw(p, "true", 4);
                 break;
-            }
-            case cJSON_String: {
-                out = print_string(item, p);
+            case cJSON_Number:
+                n = print_number(item, p);
                 break;
-            }
-            case cJSON_Array: {
-                out = print_array(item, depth, fmt, p);
+            case cJSON_String:
+                n = print_string(item, p);
                 break;
-            }
-            case cJSON_Object: {
-                out = print_object(item, depth, fmt, p);
+            case cJSON_Array:
+            case cJSON_Object:
+                object = (item->type & cJSON_Object) != 0;
+                if (!(n = print_raw(p, object ? "{\n" : "[", object && fmt ? 2 : 1))) break;
+                len += n;
+                if (!lazy_complete(item)) {
+                    n = 0;
+                    break;
+                }
+                if (item->child) {      // 转去输出第一个成员
+                    if (!(frame = treestack_push(&st))) {
+                        n = 0;
+                        break;
+                    }
+                    frame->source = item;
+                    depth++;
+                    item = item->child;
+                    continue;
+                }
+                if (object && fmt && depth > 1) {   // 空对象：格式化时为 "{\n" + 上一层缩进 + "}"
+                    if (!print_indent(p, depth - 1)) n = 0;
+                    len += depth - 1;
+                }
+                if (n) n = print_raw(p, object ? "}" : "]", 1);
                 break;
-            }
             default:
+                n = 0;
                 break;
         }
-    } else {
-        switch ((item->type) & 255) {
-            case cJSON_NULL: {
-                out = cJSON_strdup("null");
-                break;
-            }
-            case cJSON_False: {
-                out = cJSON_strdup("false");
-                break;
-            }
-            case cJSON_True: {
-                out = cJSON_strdup("true");
-                break;
-            }
-            case cJSON_Number: {
-                out = print_number(item, 0);
-                break;
-            }
-            case cJSON_String: {
-                out = print_string(item, 0);
-                break;
-            }
-            case cJSON_Array: {
-                out = print_array(item, depth, fmt, 0);
+        if (!n) break;
+        len += n;
+
+        /* 值已输出：还有兄弟时输出分隔符（格式化时数组加空格、对象加换行），否则关闭容器回到上一层 */
+        while (st.depth) {
+            frame = &st.frames[st.depth - 1];
+            object = (frame->source->type & cJSON_Object) != 0;
+            if (item->next) {
+                if ((n = print_raw(p, object ? ",\n" : ", ", fmt ? 2 : 1))) len += n;
+                item = item->next;
                 break;
             }
-            case cJSON_Object: {
-                out = print_object(item, depth, fmt, 0);
-                break;
+            depth--;
+            if (object && fmt) {
+                if ((n = print_raw(p, "\n", 1)) && depth > 0) n = print_indent(p, depth);
+                len += 1 + depth;
+                if (!n) break;
             }
-            default:
-                break;
+            if (!(n = print_raw(p, object ? "}" : "]", 1))) break;
+            len++;
+            item = frame->source;
+            st.depth--;
         }
+        if (!n || !st.depth) break;
     }
-    return out;
+    treestack_free(&st);
+    return n ? len : 0;
 }
 
-/**
- * @brief 将 cJSON 数组转换为 JSON 字符串
- *
- * @param item cJSON 对象
- * @param depth 当前对象的嵌套深度
- * @param fmt 是否格式化输出
- * @param p 指向 printbuffer 的指针，用于存储转换后的字符串
- * @return char* 成功时返回转换后的字符串，失败时返回 NULL
+/*
+ * 容器索引
+ * 对象：以大小写折叠后的键哈希做开放寻址（线性探测），槽数为 2 的幂、装载率不超过 1/2。
+ * 折叠后相同的键只登记链表中最靠前的成员，与线性查找返回第一个匹配项的语义一致；
+ * 被它遮蔽的成员只计入 dups，登记的成员被移除时再从链表中补位。
+ * 数组：按位置保存子节点指针，下标访问为 O(1)，中间插入/删除用 memmove。
+ * 两者都记录子节点数。索引与槽位（或指针表）一次分配，由 cJSON_Delete 一并释放；
+ * 引用节点与原容器共享 child，从不建立索引。
  */
-static char *print_array(cJSON *item, int depth, int fmt, printbuffer *p) {
-    char **entries;
-    char *out = NULL, *ptr, *ret;
-    size_t len = 5;
-    cJSON *child = item->child;
-    size_t numentries = 0, i = 0, fail = 0;
-    size_t tmplen = 0;
-
-    while (child) numentries++, child = child->next;    // 计算数组元素个数
-
-    if (!numentries) {
-        if (p) out = ensure(p, 3);
-        else out = (char *) cJSON_malloc(3);
-        if (out) strcpy(out, "[]");
-        return out;
-    }
-
-    if (p) {    // 为数组元素分配内存
-        i = p->offset;
-        ptr = ensure(p, 1);
-        if (!ptr) return NULL;
-        *ptr = '[';
-        p->offset++;
-        child = item->child;
-
-        while (child && !fail) {
-            print_value(child, depth + 1, fmt, p);
-            p->offset = update_offset(p);
-            if (child->next) {  // 添加逗号
-                len = fmt ? 2 : 1;          // 逗号和空格
-                ptr = ensure(p, len + 1);
-                if (!ptr) return NULL;
-                *ptr++ = ',';
-                if (fmt) *ptr++ = ' ';
-                *ptr = 0;
-                p->offset += len;
-            }
-            child = child->next;
-        }
+#ifndef CJSON_INDEX_LAZY_THRESHOLD
+#define CJSON_INDEX_LAZY_THRESHOLD 32   // 查找或按下标访问时沿链表走了这么多步就自动建立索引，0 表示不自动建立
+#endif
+#define CJSON_INDEX_MIN_SLOTS 16
 
-        ptr = ensure(p, 2);
-        if (!ptr) return NULL;
-        *ptr++ = ']';
-        *ptr = 0;
-        out = p->buffer + i;
-    } else {
-        // 为数组元素分配内存
-        entries = (char **) cJSON_malloc(numentries * sizeof(char *));
-        if (!entries) return NULL;
-        memset(entries, 0, numentries * sizeof(char *));
-
-        child = item->child;
-        while (child && !fail) {
-            ret = print_value(child, depth + 1, fmt, 0);
-            entries[i++] = ret;
-            if (ret) len += strlen(ret) + 2 + (fmt ? 1 : 0);        // 字符串长度 + 逗号 + 空格
-            else fail = 1;
-            child = child->next;
-        }
-
-        if (!fail) out = (char *) cJSON_malloc(len);
-        if (!out) fail = 1;
-
-        if (fail) {
-            for (i = 0; i < numentries; i++) if (entries[i]) cJSON_free(entries[i]);
-            cJSON_free(entries);
-            return NULL;
-        }
+typedef struct {
+    cJSON *item;
+    unsigned hash;
+} cJSON_IndexSlot;
+
+struct cJSON_Index {
+    size_t count;           // 子节点数
+    size_t used;            // 对象：已登记的成员数
+    size_t dups;            // 对象：被同名成员遮蔽、未登记的成员数
+    size_t mask;            // 对象：槽数 - 1
+    cJSON_IndexSlot *slots; // 对象：哈希槽，紧跟在结构体之后
+    size_t capacity;        // 数组：指针表容量
+    cJSON **items;          // 数组：按位置排列的子节点，紧跟在结构体之后
+};
+
+static cJSON_Index *index_new(size_t nslots) {
+    cJSON_Index *idx = (cJSON_Index *) cJSON_malloc(sizeof(cJSON_Index) + nslots * sizeof(cJSON_IndexSlot));
+    if (!idx) return NULL;
+    idx->count = idx->used = idx->dups = 0;
+    idx->mask = nslots - 1;
+    idx->slots = (cJSON_IndexSlot *) (idx + 1);
+    memset(idx->slots, 0, nslots * sizeof(cJSON_IndexSlot));
+    idx->capacity = 0;
+    idx->items = NULL;
+    return idx;
+}
 
-        *out = '[';
-        ptr = out + 1;
-        *ptr = 0;
-        for (i = 0; i < numentries; i++) {
-            tmplen = strlen(entries[i]);
-            memcpy(ptr, entries[i], tmplen);
-            ptr += tmplen;
-            if (i != numentries - 1) {      // 添加逗号
-                *ptr++ = ',';
-                if (fmt) {
-                    *ptr++ = ' ';
-                }
-                *ptr = 0;
-            }
-            cJSON_free(entries[i]);
-        }
-        cJSON_free(entries);
-        *ptr++ = ']';
-        *ptr++ = 0;
-    }
-    return out;
-}
-
-static char *print_object(cJSON *item, int depth, cJSON_bool fmt, printbuffer *p) {
-    char **entries = NULL, **names = NULL;
-    char *out = NULL, *ptr, *ret, *str;
-    size_t len = 7, i = 0, j;
-    cJSON *child = item->child;
-    int numentries = 0, fail = 0;
-    size_t tmplen = 0;
-
-    while (child) numentries++, child = child->next;    // 计算对象元素个数
-
-    if (!numentries) {
-        if (p) out = ensure(p, 2);
-        else out = (char *) cJSON_malloc(2);
-        if (!out) return NULL;
-        ptr = out;
-        *ptr++ = '{';
-        if (fmt) {
-            *ptr++ = '\n';
-            for (i = 0; i < depth - 1; i++)     // 缩进
-                *ptr++ = '\t';
-        }
-        *ptr++ = '}';
-        *ptr = 0;
-        return out;
-    }
-
-    if (p) {
-        i = p->offset;
-        len = fmt ? 2 : 1;
-        ptr = ensure(p, len + 1);
-        if (!ptr) return NULL;
-        *ptr++ = '{';
-        if (fmt) *ptr++ = '\n';
-        *ptr = 0;
-        p->offset += len;
-        child = item->child;
-        depth++;
-
-        while (child) {
-            if (fmt) {
-                ptr = ensure(p, depth);
-                if (!ptr) return NULL;
-                for (j = 0; j < depth; j++)
-                    *ptr++ = '\t';
-                p->offset += depth;
-            }
-            print_string_ptr(child->string, p);
-
-            len = fmt ? 2 : 1;
-            ptr = ensure(p, len);
-            if (!ptr) return NULL;
-            *ptr++ = ':';
-            if (fmt) *ptr++ = '\t';
-            p->offset += len;
-
-            print_value(child, depth, fmt, p);
-            p->offset = update_offset(p);
-
-            len = (fmt ? 1 : 0) + (child->next ? 1 : 0);
-            ptr = ensure(p, len + 1);
-            if (child->next) *ptr++ = ',';
-            if (fmt) *ptr++ = '\n';
-            *ptr = 0;
-            p->offset += len;
-            child = child->next;
-        }
-        ptr = ensure(p, fmt ? (depth + 1) : 2);     // '}' '\0'
-        if (!ptr) return NULL;
-        if (fmt) for (i = 0; i < depth - 1; i++) *ptr++ = '\t';
-        *ptr++ = '}';
-        *ptr = 0;
-        out = (p->buffer) + i;
-    } else {
-        entries = (char **) cJSON_malloc(numentries * sizeof(char *));
-        if (!entries) return NULL;
+static cJSON_Index *array_index_new(size_t capacity) {
+    cJSON_Index *idx = (cJSON_Index *) cJSON_malloc(sizeof(cJSON_Index) + capacity * sizeof(cJSON *));
+    if (!idx) return NULL;
+    idx->count = idx->used = idx->dups = idx->mask = 0;
+    idx->slots = NULL;
+    idx->capacity = capacity;
+    idx->items = (cJSON **) (idx + 1);
+    return idx;
+}
 
-        names = (char **) cJSON_malloc(numentries * sizeof(char *));
-        if (!names) {
-            cJSON_free(entries);
-            return NULL;
-        }
-        memset(entries, 0, sizeof(char *) * numentries);
-        memset(names, 0, sizeof(char *) * numentries);
+/* 查找与 key 大小写折叠后相同的登记项，没有则返回 NULL */
+static cJSON_IndexSlot *index_find(const cJSON_Index *idx, const char *key, unsigned hash) {
+    size_t i = hash & idx->mask;
+    for (; idx->slots[i].item; i = (i + 1) & idx->mask) {
+        if (idx->slots[i].hash == hash && !cJSON_strcasecmp(idx->slots[i].item->string, key)) return &idx->slots[i];
+    }
+    return NULL;
+}
+
+/* 取成员键的哈希，尚未计算时算出并缓存在节点上 */
+static unsigned item_hash(cJSON *item) {
+    if (!item->keyhash) item->keyhash = key_hash(item->string);
+    return item->keyhash;
+}
 
-        child = item->child;
-        depth++;
-        if (fmt) len += depth;
+/* 在已知没有同名登记项、且有空槽时登记成员 */
+static void index_put(cJSON_Index *idx, cJSON *item, unsigned hash) {
+    size_t i = hash & idx->mask;
+    while (idx->slots[i].item) i = (i + 1) & idx->mask;
+    idx->slots[i].item = item;
+    idx->slots[i].hash = hash;
+    idx->used++;
+}
+
+/* 按 nslots 个槽重建对象索引 */
+static cJSON_Index *index_resize(cJSON_Index *idx, size_t nslots) {
+    cJSON_Index *bigger = index_new(nslots);
+    size_t i;
+    if (!bigger) return NULL;
+    for (i = 0; i <= idx->mask; i++) if (idx->slots[i].item) index_put(bigger, idx->slots[i].item, idx->slots[i].hash);
+    bigger->count = idx->count;
+    bigger->dups = idx->dups;
+    cJSON_free(idx);
+    return bigger;
+}
+
+/* 保证数组索引至少还能再放一个指针 */
+static cJSON_Index *array_index_reserve(cJSON_Index *idx) {
+    cJSON_Index *bigger;
+    if (idx->count < idx->capacity) return idx;
+    if (!(bigger = array_index_new(idx->capacity * 2))) return NULL;
+    memcpy(bigger->items, idx->items, idx->count * sizeof(cJSON *));
+    bigger->count = idx->count;
+    cJSON_free(idx);
+    return bigger;
+}
+
+static cJSON_bool is_array_index(const cJSON_Index *idx) {
+    return idx->items != NULL;
+}
+
+void cJSON_DropObjectIndex(cJSON *object) {
+    if (!object || !object->index) return;
+    cJSON_free(object->index);
+    object->index = NULL;
+}
+
+cJSON_bool cJSON_BuildObjectIndex(cJSON *object) {
+    cJSON_Index *idx;
+    cJSON *c;
+    size_t count = 0;
+    unsigned hash;
+    if (!object || (object->type & 255) != cJSON_Object || (object->type & cJSON_IsReference)) return 0;
+    if (object->index) return 1;
+    if (!lazy_ready(object)) return 0;
+
+    for (c = object->child; c; c = c->next) count++;
+    if (!(idx = index_new(pow2gt(count * 2 > CJSON_INDEX_MIN_SLOTS ? count * 2 : CJSON_INDEX_MIN_SLOTS)))) return 0;
+    idx->count = count;
+    for (c = object->child; c; c = c->next) {
+        if (!c->string) continue;
+        hash = item_hash(c);
+        if (index_find(idx, c->string, hash)) idx->dups++;
+        else index_put(idx, c, hash);
+    }
+    object->index = idx;
+    return 1;
+}
+
+cJSON_bool cJSON_BuildArrayIndex(cJSON *array) {
+    cJSON_Index *idx;
+    cJSON *c;
+    size_t count = 0;
+    if (!array || (array->type & 255) != cJSON_Array || (array->type & cJSON_IsReference)) return 0;
+    if (array->index) return 1;
+    if (!lazy_ready(array)) return 0;
+
+    for (c = array->child; c; c = c->next) count++;
+    if (!(idx = array_index_new(pow2gt(count > CJSON_INDEX_MIN_SLOTS ? count : CJSON_INDEX_MIN_SLOTS)))) return 0;
+    for (c = array->child; c; c = c->next) idx->items[idx->count++] = c;
+    array->index = idx;
+    return 1;
+}
+
+/* 沿链表走了 steps 步后，视情况为容器自动建立索引（arena 中的容器除外，见 cJSON_BuildObjectIndex 的说明） */
+static void index_lazy_build(const cJSON *container, size_t steps) {
+    if (!CJSON_INDEX_LAZY_THRESHOLD || steps < CJSON_INDEX_LAZY_THRESHOLD || container->index) return;
+    if (container->type & cJSON_IsArena) return;
+    if ((container->type & 255) == cJSON_Object) cJSON_BuildObjectIndex((cJSON *) container);  // 索引只是查找缓存，不改变容器的内容
+    else cJSON_BuildArrayIndex((cJSON *) container);
+}
 
-        while (child) {
-            names[i] = str = print_string_ptr(child->string, 0);
-            entries[i++] = ret = print_value(child, depth, fmt, 0);
-            if (str && ret) len += strlen(ret) + strlen(str) + 2 + (fmt ? 2 + depth : 0);
-            else fail = 1;
-            child = child->next;
+/* 在对象索引中登记成员，已有同名成员时只计数 */
+static void object_index_put(cJSON *object, cJSON *item) {
+    cJSON_Index *idx = object->index, *bigger;
+    unsigned hash;
+    if (!item->string) return;
+    hash = item_hash(item);
+    if (index_find(idx, item->string, hash)) {
+        idx->dups++;
+        return;
+    }
+    if ((idx->used + 1) * 2 > idx->mask + 1) {
+        if (!(bigger = index_resize(idx, (idx->mask + 1) * 2))) {
+            cJSON_DropObjectIndex(object);   // 内存不足时放弃索引，之后按需重建
+            return;
         }
+        object->index = idx = bigger;
+    }
+    index_put(idx, item, hash);
+}
 
-        if (!fail) out = (char *) cJSON_malloc(len);
-        if (!out) fail = 1;
+/* 子节点 item 已追加到容器末尾 */
+static void index_add(cJSON *parent, cJSON *item) {
+    cJSON_Index *idx = parent->index;
+    if (!idx) return;
+    if (!is_array_index(idx)) {
+        idx->count++;
+        object_index_put(parent, item);
+        return;
+    }
+    if (!(idx = array_index_reserve(idx))) {
+        cJSON_DropObjectIndex(parent);
+        return;
+    }
+    parent->index = idx;
+    idx->items[idx->count++] = item;
+}
 
-        if (fail) {
-            for (i = 0; i < numentries; i++) {
-                if (names[i]) cJSON_free(names[i]);
-                if (entries[i]) cJSON_free(entries[i]);
-            }
-            return NULL;
+/*
+ * 子节点 item 已插入到容器的第 pos 个位置。
+ * 对象中没有同名成员时直接登记，否则先后顺序可能改变，放弃索引。
+ */
+static void index_insert(cJSON *parent, cJSON *item, size_t pos) {
+    cJSON_Index *idx = parent->index;
+    if (!idx) return;
+    if (is_array_index(idx)) {
+        if (pos > idx->count || !(idx = array_index_reserve(idx))) {
+            cJSON_DropObjectIndex(parent);
+            return;
         }
+        parent->index = idx;
+        memmove(idx->items + pos + 1, idx->items + pos, (idx->count - pos) * sizeof(cJSON *));
+        idx->items[pos] = item;
+        idx->count++;
+        return;
+    }
+    if (item->string && index_find(idx, item->string, item_hash(item))) {
+        cJSON_DropObjectIndex(parent);
+        return;
+    }
+    idx->count++;
+    object_index_put(parent, item);
+}
 
-        *out = '{';
-        ptr = out + 1;
-        if (fmt) *ptr++ = '\n';
-        *ptr = 0;
-        for (i = 0; i < numentries; i++) {
-            if (fmt) {
-                for (j = 0; j < depth; j++)
-                    *ptr++ = '\t';
+/* 容器第 pos 个子节点 item 即将被移除（调用时仍在链表中） */
+static void index_remove(cJSON *parent, cJSON *item, size_t pos) {
+    cJSON_Index *idx = parent->index;
+    cJSON_IndexSlot *slot;
+    cJSON *c;
+    size_t i, j, home;
+    if (!idx) return;
+    if (is_array_index(idx)) {
+        if (pos >= idx->count || idx->items[pos] != item) {
+            cJSON_DropObjectIndex(parent);  // 索引与链表不一致，放弃索引
+            return;
+        }
+        idx->count--;
+        memmove(idx->items + pos, idx->items + pos + 1, (idx->count - pos) * sizeof(cJSON *));
+        return;
+    }
+    idx->count--;
+    if (!item->string) return;
+    if (!(slot = index_find(idx, item->string, item_hash(item)))) {
+        cJSON_DropObjectIndex(parent);  // 索引与链表不一致，放弃索引
+        return;
+    }
+    if (slot->item != item) {   // 被遮蔽的成员
+        idx->dups--;
+        return;
+    }
+    if (idx->dups) {    // 由后面第一个同名成员补位
+        for (c = item->next; c; c = c->next) {
+            if (c->string && (!c->keyhash || c->keyhash == item->keyhash) && !cJSON_strcasecmp(c->string, item->string)) {
+                slot->item = c;
+                idx->dups--;
+                return;
             }
-            tmplen = strlen(names[i]);
-            memcpy(ptr, names[i], tmplen);
-            ptr += tmplen;
-            *ptr++ = ':';
-            if (fmt) *ptr++ = ' ';
-            tmplen = strlen(entries[i]);
-            memcpy(ptr, entries[i], tmplen);
-            ptr += tmplen;
-            if (i != numentries - 1) *ptr++ = ',';
-            if (fmt) *ptr++ = '\n';
-            *ptr = 0;
-            cJSON_free(names[i]);
-            cJSON_free(entries[i]);
         }
+    }
 
-        cJSON_free(names);
-        cJSON_free(entries);
-        if (fmt) {
-            for (i = 0; i < depth - 1; i++) *ptr++ = '\t';
+    /* 线性探测的删除：把后续本应更靠前的项向前移动填补空位 */
+    i = slot - idx->slots;
+    for (j = (i + 1) & idx->mask; idx->slots[j].item; j = (j + 1) & idx->mask) {
+        home = idx->slots[j].hash & idx->mask;
+        if (((j - home) & idx->mask) >= ((j - i) & idx->mask)) {
+            idx->slots[i] = idx->slots[j];
+            i = j;
         }
-        *ptr++ = '}';
-        *ptr = 0;
     }
-    return out;
+    idx->slots[i].item = NULL;
+    idx->used--;
 }
 
 int cJSON_GetArraySize(const cJSON *array) {
-    cJSON *c = array->child;
-    int i = 0;
-    while (c) {
-        ++i;
-        c = c->next;
-    }
-    return i;
+    cJSON *c;
+    size_t i = 0;
+    if (!array || !lazy_ready(array)) return 0;
+    if (array->index) return (int) array->index->count;
+    for (c = array->child; c; c = c->next) i++;
+    index_lazy_build(array, i);
+    return (int) i;
+}
+
+/* 取第 which 个子节点：有数组索引时为 O(1)，否则沿链表查找，走得太远时自动建立索引 */
+static cJSON *get_array_item(const cJSON *array, size_t which) {
+    cJSON *c;
+    size_t i;
+    if (!lazy_ready(array)) return NULL;
+    if (array->index && is_array_index(array->index)) return which < array->index->count ? array->index->items[which] : NULL;
+    for (c = array->child, i = 0; c && i < which; i++) c = c->next;
+    if ((array->type & 255) == cJSON_Array) index_lazy_build(array, i);
+    return c;
 }
 
 cJSON *cJSON_GetArrayItem(const cJSON *array, int item) {
-    cJSON *c = array->child;
-    while (c && item > 0) {
-        --item;
-        c = c->next;
+    if (!array) return NULL;
+    return get_array_item(array, item > 0 ? (size_t) item : 0);
+}
+
+/* 按键查找对象成员，hash 为 key_hash(string)。有索引时为 O(1)，线性扫描过长时自动建立索引 */
+static cJSON *get_object_item(const cJSON *object, const char *string, unsigned hash, cJSON_bool case_sensitive) {
+    cJSON_IndexSlot *slot;
+    cJSON *c;
+    size_t scanned = 0;
+    if (!object || !string || !lazy_ready(object)) return NULL;
+
+    if (object->index) {
+        if (!(slot = index_find(object->index, string, hash))) return NULL;
+        c = slot->item;
+        if (!case_sensitive || !strcmp(c->string, string)) return c;
+        if (!object->index->dups) return NULL;
+        for (c = c->next; c; c = c->next) {     // 只有大小写不同的同名成员
+            if (c->string && (!c->keyhash || c->keyhash == hash) && !strcmp(c->string, string)) return c;
+        }
+        return NULL;
+    }
+
+    for (c = object->child; c; c = c->next, scanned++) {
+        if (!c->string || (c->keyhash && c->keyhash != hash)) continue;     // 哈希不同的成员一次整数比较即可排除
+        if (!(case_sensitive ? strcmp(c->string, string) : cJSON_strcasecmp(c->string, string))) break;
     }
+    if ((object->type & 255) == cJSON_Object) index_lazy_build(object, scanned);
     return c;
 }
 
 cJSON *cJSON_GetObjectItem(const cJSON *object, const char *string) {
-    cJSON *c = object->child;
-    while (c && cJSON_strcasecmp(c->string, string)) c = c->next;
-    return c;
+    return string ? get_object_item(object, string, key_hash(string), 0) : NULL;
+}
+
+cJSON *cJSON_GetObjectItemCaseSensitive(const cJSON *object, const char *string) {
+    return string ? get_object_item(object, string, key_hash(string), 1) : NULL;
+}
+
+cJSON_Key cJSON_PrepareKey(const char *string) {
+    cJSON_Key key;
+    key.string = string;
+    key.hash = string ? key_hash(string) : 0;
+    return key;
+}
+
+cJSON *cJSON_GetObjectItemByKey(const cJSON *object, const cJSON_Key *key) {
+    return key ? get_object_item(object, key->string, key->hash, 1) : NULL;
+}
+
+/*
+ * 子节点链表中，首节点的 prev 指向尾节点（尾节点的 next 仍为 NULL），因此追加为 O(1)。
+ * 手工拼接的链表首节点 prev 可能为空或已过期，此时沿 next 找到真正的尾节点。
+ */
+static cJSON *list_tail(const cJSON *parent) {
+    cJSON *tail = parent->child->prev;
+    if (!tail) tail = parent->child;
+    while (tail->next) tail = tail->next;
+    return tail;
 }
 
 /* 将一个 cJSON 对象添加到数组链中 */
@@ -1018,30 +4068,40 @@ static void suffix_object(cJSON *prev, cJSON *item) {
  * @return 新创建的 cJSON 引用项  ,如果内存分配失败则返回 NULL
  */
 static cJSON *create_reference(cJSON *item) {
-    cJSON *ref = cJSON_New_Item();
-    if (!ref) return NULL;
+    cJSON *ref;
+    if (!lazy_ready(item) || !(ref = cJSON_New_Item())) return NULL;    // 引用共享展开后的子节点
     memcpy(ref, item, sizeof(cJSON));
     ref->string = NULL;
+    ref->keyhash = 0;
+    ref->type &= ~(cJSON_IsArena | cJSON_StringIsConst);   // 引用节点本身总是堆上分配的
     ref->type |= cJSON_IsReference;
     ref->next = ref->prev = NULL;
+    ref->index = NULL;      // 索引归原对象所有
     return ref;
 }
 
 void cJSON_AddItemToArray(cJSON *array, cJSON *item) {
-    cJSON *c = array->child;
-    if (!item) return;
+    cJSON *c, *tail;
+    if (!item || !lazy_ready(array)) return;
+    c = array->child;
+    item->next = NULL;
     if (!c) {
         array->child = item;
+        item->prev = item;
     } else {
-        while (c && c->next) c = c->next;
-        suffix_object(c, item);
+        tail = list_tail(array);
+        suffix_object(tail, item);
+        c->prev = item;
     }
+    index_add(array, item);
 }
 
 void cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item) {
     if (!item) return;
-    if (item->string) cJSON_free(item->string);
+    if (!(item->type & cJSON_StringIsConst) && item->string) string_free(item, item->string);
     item->string = cJSON_strdup(string);
+    item->keyhash = item->string ? key_hash(item->string) : 0;
+    item->type &= ~cJSON_StringIsConst;
     cJSON_AddItemToArray(object, item);
 }
 
@@ -1054,8 +4114,9 @@ void cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item) {
  */
 void cJSON_AddItemToObjectCS(cJSON *object, const char *string, cJSON *item) {
     if (!item) return;
-    if (!(item->type & cJSON_StringIsConst) && item->string) cJSON_free(item->string);
+    if (!(item->type & cJSON_StringIsConst) && item->string) string_free(item, item->string);
     item->string = (char *) string;
+    item->keyhash = string ? key_hash(string) : 0;
     item->type |= cJSON_StringIsConst;
     cJSON_AddItemToArray(object, item);
 }
@@ -1068,30 +4129,51 @@ void cJSON_AddItemReferenceToObject(cJSON *object, const char *string, cJSON *it
     cJSON_AddItemToObject(object, string, create_reference(item));
 }
 
-/* 从 cJSON 数组中分离指定的 cJSON 项 */
-cJSON *cJSON_DetachItemFromArray(cJSON *array, int which) {
-    cJSON *c = array->child;
-    while (c && which > 0) {
-        --which;
-        c = c->next;
-    }
-    if (!c) return NULL;
-    if (c->prev) c->prev->next = c->next;
+/* 从父节点的链表中摘下第 pos 个子节点 c（对象按键摘下时 pos 不使用） */
+static cJSON *detach_item(cJSON *parent, cJSON *c, size_t pos) {
+    index_remove(parent, c, pos);
+    if (c != parent->child) c->prev->next = c->next;
     if (c->next) c->next->prev = c->prev;
-    if (c == array->child) array->child = c->next;
+    if (c == parent->child) parent->child = c->next;
+    else if (!c->next) parent->child->prev = c->prev;   // 摘下的是尾节点
     c->prev = c->next = NULL;
     return c;
 }
 
+/* 用 newitem 替换父节点中的第 pos 个子节点 c，并释放 c */
+static void replace_item(cJSON *parent, cJSON *c, cJSON *newitem, size_t pos) {
+    cJSON_Index *idx = parent->index;
+    if (idx && is_array_index(idx) && pos < idx->count && idx->items[pos] == c) idx->items[pos] = newitem;
+    else if (idx && is_array_index(idx)) cJSON_DropObjectIndex(parent);
+    else index_remove(parent, c, pos);
+
+    newitem->next = c->next;
+    newitem->prev = c->prev;
+    if (newitem->next) newitem->next->prev = newitem;
+    if (c == parent->child) {
+        if (c->prev == c) newitem->prev = newitem;  // 唯一的子节点
+        parent->child = newitem;
+    } else {
+        newitem->prev->next = newitem;
+        if (!newitem->next) parent->child->prev = newitem;  // 替换的是尾节点
+    }
+    c->next = c->prev = NULL;
+    if (parent->index && !is_array_index(parent->index)) index_insert(parent, newitem, pos);
+    cJSON_Delete(c);
+}
+
+/* 从 cJSON 数组中分离指定的 cJSON 项 */
+cJSON *cJSON_DetachItemFromArray(cJSON *array, int which) {
+    size_t pos = which > 0 ? (size_t) which : 0;
+    cJSON *c = get_array_item(array, pos);
+    if (!c) return NULL;
+    return detach_item(array, c, pos);
+}
+
 /* 从 cJSON 对象中分离指定的 cJSON 项 */
 cJSON *cJSON_DetachItemFromObject(cJSON *object, const char *string) {
-    cJSON *c = object->child;
-    int i = 0;
-    while (c && !strcasecmp(c->string, string)) {
-        i++;
-        c = c->next;
-    }
-    if (c) return cJSON_DetachItemFromArray(object, i);
+    cJSON *c = cJSON_GetObjectItem(object, string);
+    if (c) return detach_item(object, c, 0);
     return NULL;
 }
 
@@ -1105,11 +4187,8 @@ void cJSON_DeleteItemFromObject(cJSON *object, const char *string) {
 
 /* 将 cJSON 项插入到数组链中指定的位置 */
 void cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newitem) {
-    cJSON *c = array->child;
-    while (c && which > 0) {
-        --which;
-        c = c->next;
-    }
+    size_t pos = which > 0 ? (size_t) which : 0;
+    cJSON *c = get_array_item(array, pos);
     if (!c) {
         cJSON_AddItemToArray(array, newitem);
         return;
@@ -1117,39 +4196,30 @@ void cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newitem) {
     newitem->next = c;
     newitem->prev = c->prev;
     c->prev = newitem;
-    if (c == array->child) array->child = newitem;
+    if (c == array->child) array->child = newitem;  // 新首节点继承指向尾节点的 prev
     else newitem->prev->next = newitem;
+    index_insert(array, newitem, pos);
 }
 
 /* 替换数组链中指定位置的 cJSON 项 */
 void cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem) {
-    cJSON *c = array->child;
-    while (c && which > 0) {
-        --which;
-        c = c->next;
-    }
+    size_t pos = which > 0 ? (size_t) which : 0;
+    cJSON *c = get_array_item(array, pos);
     if (!c) return;
-    newitem->next = c->next;
-    newitem->prev = c->prev;
-    if (newitem->next) newitem->next->prev = newitem;
-    if (c == array->child) array->child = newitem;
-    else newitem->prev->next = newitem;
-    c->next = c->prev = NULL;
-    cJSON_Delete(c);
+    replace_item(array, c, newitem, pos);
 }
 
 /* 替换对象链中指定键名的 cJSON 项 */
 void cJSON_ReplaceItemInObject(cJSON *object, const char *string, cJSON *newitem) {
-    int i = 0;
-    cJSON *c = object->child;
-    while (c && cJSON_strcasecmp(c->string, string)) {
-        i++;
-        c = c->next;
-    }
-    if (c) {
-        newitem->string = cJSON_strdup(string);
-        cJSON_ReplaceItemInArray(object, i, newitem);
-    }
+    cJSON *c = cJSON_GetObjectItem(object, string);
+    char *key;
+    if (!c) return;
+    key = cJSON_strdup(string);     // 先复制：string 可能就是 newitem->string
+    if (!(newitem->type & cJSON_StringIsConst) && newitem->string) string_free(newitem, newitem->string);
+    newitem->string = key;
+    newitem->keyhash = newitem->string ? key_hash(newitem->string) : 0;
+    newitem->type &= ~cJSON_StringIsConst;
+    replace_item(object, c, newitem, 0);
 }
 
 /* cJSON 各种类型的创建函数 */
@@ -1188,10 +4258,16 @@ cJSON *cJSON_CreateNumber(double num) {
     return item;
 }
 
+cJSON *cJSON_CreateInt64(long long num) {
+    cJSON *item = cJSON_New_Item();
+    if (item) set_int64(item, num);
+    return item;
+}
+
 cJSON *cJSON_CreateString(const char *string) {
     cJSON *item = cJSON_New_Item();
     if (item) {
-        item->type = cJSON_String;
+        item->type = cJSON_String | cJSON_StringIsPooled;
         item->valuestring = cJSON_strdup(string);
         if (!item->valuestring) {
             cJSON_Delete(item);
@@ -1228,6 +4304,7 @@ cJSON *cJSON_CreateIntArray(const int *numbers, int count) {
         else suffix_object(p, n);
         p = n;
     }
+    if (a && a->child) a->child->prev = n;
     return a;
 }
 
@@ -1244,6 +4321,7 @@ cJSON *cJSON_CreateFloatArray(const float *numbers, int count) {
         else suffix_object(p, n);
         p = n;
     }
+    if (a && a->child) a->child->prev = n;
     return a;
 }
 
@@ -1260,6 +4338,7 @@ cJSON *cJSON_CreateDoubleArray(const double *numbers, int count) {
         else suffix_object(p, n);
         p = n;
     }
+    if (a && a->child) a->child->prev = n;
     return a;
 }
 
@@ -1276,18 +4355,20 @@ cJSON *cJSON_CreateStringArray(const char **strings, int count) {
         else suffix_object(p, n);
         p = n;
     }
+    if (a && a->child) a->child->prev = n;
     return a;
 }
 
 
-cJSON *cJSON_Duplicate(cJSON *item, int recurse) {
-    cJSON *newitem, *cptr, *nptr = NULL, *newchild;
-    if (!item) return NULL;
-    newitem = cJSON_New_Item();
-    if (!newitem) return NULL;
+/* 复制单个节点（不含子节点），副本的字符串总是自己持有 */
+static cJSON *duplicate_node(const cJSON *item) {
+    cJSON *newitem;
+    if (!lazy_complete(item) || !(newitem = cJSON_New_Item())) return NULL;    // 惰性容器先整个展开，副本总是普通节点
 
-    newitem->type = item->type & (~cJSON_IsReference);
+    newitem->type = (item->type & ~(cJSON_IsReference | cJSON_IsArena | cJSON_StringIsConst | cJSON_IsInSitu)) |
+                    cJSON_StringIsPooled;
     newitem->valueint = item->valueint;
+    newitem->valueint64 = item->valueint64;
     newitem->valuedouble = item->valuedouble;
     if (item->valuestring) {
         newitem->valuestring = cJSON_strdup(item->valuestring);
@@ -1299,34 +4380,60 @@ cJSON *cJSON_Duplicate(cJSON *item, int recurse) {
 
     if (item->string) {
         newitem->string = cJSON_strdup(item->string);
+        newitem->keyhash = item->keyhash;
         if (!newitem->string) {
             cJSON_Delete(newitem);
             return NULL;
         }
     }
+    return newitem;
+}
 
-    if (!recurse) return newitem;       // 不递归拷贝
+/* 深拷贝用显式的容器栈代替递归：每层记录副本容器、副本的尾节点和下一个要复制的原成员 */
+cJSON *cJSON_Duplicate(cJSON *item, int recurse) {
+    treestack st;
+    treeframe *frame;
+    cJSON *newitem, *newchild;
+    const cJSON *source;
 
-    if (!(item->type & cJSON_IsReference) && item->child) {
-        cptr = item->child;
-        while (cptr) {
-            newchild = cJSON_Duplicate(cptr, 1); // 递归拷贝
-            if (!newchild) {
-                cJSON_Delete(newitem);
-                return NULL;
-            }
-            if (nptr) {
-                nptr->next = newchild;
-                newchild->prev = nptr;
-                nptr = newchild;
-            } else {
-                newitem->child = newchild;
-                newchild->prev = NULL;
-                nptr = newchild;
-            }
-            cptr = cptr->next;
+    if (!item) return NULL;
+    if (!(newitem = duplicate_node(item))) return NULL;
+    if (!recurse || (item->type & cJSON_IsReference) || !item->child) return newitem;   // 不递归拷贝
+
+    treestack_init(&st);
+    frame = treestack_push(&st);
+    frame->container = newitem;
+    frame->last = NULL;
+    frame->source = item->child;
+    while (st.depth) {
+        frame = &st.frames[st.depth - 1];
+        if (!(source = frame->source)) {    // 这一层复制完毕
+            frame->container->child->prev = frame->last;    // 首节点的 prev 指向尾节点
+            st.depth--;
+            continue;
+        }
+        frame->source = source->next;
+        if (!(newchild = duplicate_node(source))) break;
+        if (frame->last) {
+            frame->last->next = newchild;
+            newchild->prev = frame->last;
+        } else {
+            frame->container->child = newchild;
+        }
+        frame->last = newchild;
+
+        if (!(source->type & cJSON_IsReference) && source->child) {    // 转去复制子节点
+            if (!(frame = treestack_push(&st))) break;
+            frame->container = newchild;
+            frame->last = NULL;
+            frame->source = source->child;
         }
     }
+    treestack_free(&st);
+    if (st.depth) {
+        cJSON_Delete(newitem);
+        return NULL;
+    }
     return newitem;
 }
 
@@ -1354,4 +4461,76 @@ void cJSON_Minify(char *json) {
         }
     }
     *into = 0;
-}
\ No newline at end of file
+}
+
+/* 上下文变体：在 ctx 的作用域内调用对应的接口，ctx 为 NULL 时使用全局的内存分配函数 */
+cJSON *cJSON_Parse_Ctx(cJSON_Context *ctx, const char *value) {
+    context_scope scope(ctx);
+    return cJSON_Parse(value);
+}
+
+cJSON *cJSON_ParseWithLengthOpts_Ctx(cJSON_Context *ctx, const char *value, size_t buffer_length,
+                                     const char **return_parse_end, cJSON_bool require_null_terminated) {
+    context_scope scope(ctx);
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+cJSON *cJSON_ParseFile_Ctx(cJSON_Context *ctx, const char *path) {
+    context_scope scope(ctx);
+    return cJSON_ParseFile(path);
+}
+
+char *cJSON_Print_Ctx(cJSON_Context *ctx, cJSON *item) {
+    context_scope scope(ctx);
+    return cJSON_Print(item);
+}
+
+char *cJSON_PrintUnformatted_Ctx(cJSON_Context *ctx, cJSON *item) {
+    context_scope scope(ctx);
+    return cJSON_PrintUnformatted(item);
+}
+
+void cJSON_Free_Ctx(cJSON_Context *ctx, void *ptr) {
+    context_scope scope(ctx);
+    cJSON_free(ptr);
+}
+
+void cJSON_Delete_Ctx(cJSON_Context *ctx, cJSON *item) {
+    context_scope scope(ctx);
+    cJSON_Delete(item);
+}
+
+cJSON *cJSON_Duplicate_Ctx(cJSON_Context *ctx, cJSON *item, cJSON_bool recurse) {
+    context_scope scope(ctx);
+    return cJSON_Duplicate(item, recurse);
+}
+
+cJSON *cJSON_CreateNull_Ctx(cJSON_Context *ctx) {
+    context_scope scope(ctx);
+    return cJSON_CreateNull();
+}
+
+cJSON *cJSON_CreateBool_Ctx(cJSON_Context *ctx, cJSON_bool b) {
+    context_scope scope(ctx);
+    return cJSON_CreateBool(b);
+}
+
+cJSON *cJSON_CreateNumber_Ctx(cJSON_Context *ctx, double num) {
+    context_scope scope(ctx);
+    return cJSON_CreateNumber(num);
+}
+
+cJSON *cJSON_CreateString_Ctx(cJSON_Context *ctx, const char *string) {
+    context_scope scope(ctx);
+    return cJSON_CreateString(string);
+}
+
+cJSON *cJSON_CreateArray_Ctx(cJSON_Context *ctx) {
+    context_scope scope(ctx);
+    return cJSON_CreateArray();
+}
+
+cJSON *cJSON_CreateObject_Ctx(cJSON_Context *ctx) {
+    context_scope scope(ctx);
+    return cJSON_CreateObject();
+}
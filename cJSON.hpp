@@ -21,12 +21,20 @@ extern "C" {
 
 #define cJSON_IsReference 256	// 是否引用外部数据
 #define cJSON_StringIsConst 512 // 字符串是否是常量
+#define cJSON_IsArena 1024		// 节点及其 valuestring 由 arena 分配
+#define cJSON_IsInSitu 2048		// valuestring 指向就地解析的输入缓冲区
+#define cJSON_StringIsPooled 4096 // valuestring 和 string 由 cJSON_malloc 分配，释放时短字符串可回收到节点池；换成同样由 cJSON_malloc（或 InitHooks 的 malloc_fn）分配的缓冲区或就地截短都是安全的
+#define cJSON_IsLazy 8192			// 尚未展开的容器（cJSON_ParseLazy()）：child 为空，valuestring 指向输入中的原文
+#define cJSON_NumberIsRaw 16384	// 保留原文的数字（cJSON_KeepNumberText）：valuestring 是原文，数值须通过 cJSON_GetNumberValue() 读取
+#define cJSON_NumberIsInt64 32768	// 整数数字：valueint64 是精确值，valuedouble 是最接近的 double
 
 #define cJSON_bool int
 
 /* cJSON structure */
 typedef struct cJSON {
-	// 下一个节点、上一个节点
+	// 下一个节点、上一个节点（首节点的 prev 指向尾节点，尾节点的 next 为 NULL）
+	// 接口变更：原来首节点的 prev 为 NULL。向前遍历时不能以 prev == NULL 作为结束条件（会无限循环），
+	// 应在回到 parent->child 时停止；判断是否为首节点也应与 parent->child 比较。
 	struct cJSON *next, *prev;
 
 	// 子节点
@@ -36,6 +44,9 @@ typedef struct cJSON {
 	// cJSON_Invalid、cJSON_False、cJSON_True、cJSON_NULL、cJSON_Number、cJSON_String、cJSON_Array、cJSON_Object、cJSON_Raw
 	int type;
 
+	// string 的哈希，由解析和 cJSON_Add*ToObject 计算；直接修改 string 后须将其置 0
+	unsigned int keyhash;
+
 	// 字符串，类型为 cJSON_String、cJSON_Raw
 	char *valuestring;
 
@@ -45,8 +56,14 @@ typedef struct cJSON {
 	// 数字，存放浮点数，类型为 cJSON_Number
 	double valuedouble;
 
+	// 数字，存放 64 位整数，只在带 cJSON_NumberIsInt64 标记时有效，通过 cJSON_GetInt64() 读取
+	long long valueint64;
+
 	// Key 键值
 	char *string;
+
+	// 对象成员的哈希索引，按需建立，由库内部维护
+	struct cJSON_Index *index;
 } cJSON;
 
 typedef struct cJSON_Hooks {
@@ -62,6 +79,182 @@ typedef struct cJSON_Hooks {
  */
 [[maybe_unused]] extern void cJSON_InitHooks(cJSON_Hooks *hooks);
 
+/* 解析错误码 */
+#define cJSON_ErrorNone 0	// 没有错误
+#define cJSON_ErrorSyntax 1 // 语法错误
+#define cJSON_ErrorMemory 2 // 内存不足
+#define cJSON_ErrorDepth 3	// 嵌套层数超过上下文的限制
+#define cJSON_ErrorLength 4 // 输入长度超过上下文的限制
+#define cJSON_ErrorEncoding 5 // 字符串不是合法的 UTF-8，或 \u 转义中有不成对的代理项（仅 cJSON_Validate()）
+
+/* 上下文的内存分配函数，userdata 原样传回，可指向每个线程自己的内存池 */
+typedef struct cJSON_Allocator {
+	void *(*malloc_fn)(size_t size, void *userdata);
+	void (*free_fn)(void *pointer, void *userdata);
+	void *userdata;
+} cJSON_Allocator;
+
+/* 默认的最大嵌套层数：不带上下文解析、或创建上下文时不给限制都使用它 */
+#ifndef CJSON_NESTING_LIMIT
+#define CJSON_NESTING_LIMIT 1000
+#endif
+
+/* 解析限制，0 表示不限制 */
+typedef struct cJSON_Limits {
+	size_t max_depth;  // 数组和对象的最大嵌套层数
+	size_t max_length; // 输入的最大字节数
+} cJSON_Limits;
+
+/* 最近一次解析的结果 */
+typedef struct cJSON_Error {
+	int code;	   // cJSON_Error* 错误码
+	size_t offset; // 出错位置相对输入开头的字节偏移
+	size_t line;   // 出错位置所在的行，从 1 开始；位置未知时为 0
+	size_t column; // 出错位置所在的列（按字节），从 1 开始；位置未知时为 0
+} cJSON_Error;
+
+/* cJSON 上下文：分配器、解析限制和错误信息。一个上下文同一时刻只应被一个线程使用 */
+typedef struct cJSON_Context cJSON_Context;
+
+/**
+ * @brief 创建上下文，上下文本身也从 allocator 分配。
+ * @param allocator：内存分配函数，传 NULL 使用 cJSON_InitHooks() 设置的全局函数。
+ * @param limits：解析限制，传 NULL 时只把嵌套层数限制为 CJSON_NESTING_LIMIT。
+ * @return 成功返回上下文，失败返回 NULL。
+ */
+cJSON_Context *cJSON_CreateContext(const cJSON_Allocator *allocator, const cJSON_Limits *limits);
+
+/**
+ * @brief 释放上下文，不会释放用它分配的树。
+ * @param ctx：要释放的上下文。
+ */
+void cJSON_DeleteContext(cJSON_Context *ctx);
+
+/**
+ * @brief 获取最近一次在该上下文中解析的结果。
+ * @param ctx：上下文。
+ * @return 错误信息，成功时错误码为 cJSON_ErrorNone。
+ */
+const cJSON_Error *cJSON_GetContextError(const cJSON_Context *ctx);
+
+/**
+ * @brief 设置当前线程的上下文，之后该线程上不带 _Ctx 的接口也使用它的分配器、限制和错误信息。
+ * @param ctx：上下文，传 NULL 恢复使用全局的内存分配函数。
+ * @return 之前的上下文。
+ * @note 在上下文中分配的树必须在同一个上下文中修改和释放：修改（如 cJSON_AddItemToObject()）前先设置线程上下文，
+ *       释放时用 cJSON_Delete_Ctx()。
+ */
+cJSON_Context *cJSON_SetThreadContext(cJSON_Context *ctx);
+
+/* 上下文变体：与对应的接口相同，但在调用期间使用 ctx（ctx 为 NULL 时使用全局的内存分配函数） */
+cJSON *cJSON_Parse_Ctx(cJSON_Context *ctx, const char *value);
+cJSON *cJSON_ParseWithLengthOpts_Ctx(cJSON_Context *ctx, const char *value, size_t buffer_length,
+									 const char **return_parse_end, cJSON_bool require_null_terminated);
+cJSON *cJSON_ParseFile_Ctx(cJSON_Context *ctx, const char *path);
+char *cJSON_Print_Ctx(cJSON_Context *ctx, cJSON *item);
+char *cJSON_PrintUnformatted_Ctx(cJSON_Context *ctx, cJSON *item);
+void cJSON_Free_Ctx(cJSON_Context *ctx, void *ptr);	// 释放 cJSON_Print*_Ctx() 返回的字符串
+void cJSON_Delete_Ctx(cJSON_Context *ctx, cJSON *item);
+cJSON *cJSON_Duplicate_Ctx(cJSON_Context *ctx, cJSON *item, cJSON_bool recurse);
+cJSON *cJSON_CreateNull_Ctx(cJSON_Context *ctx);
+cJSON *cJSON_CreateBool_Ctx(cJSON_Context *ctx, cJSON_bool b);
+cJSON *cJSON_CreateNumber_Ctx(cJSON_Context *ctx, double num);
+cJSON *cJSON_CreateString_Ctx(cJSON_Context *ctx, const char *string);
+cJSON *cJSON_CreateArray_Ctx(cJSON_Context *ctx);
+cJSON *cJSON_CreateObject_Ctx(cJSON_Context *ctx);
+
+/* 节点池统计 */
+typedef struct cJSON_NodePoolStats {
+	size_t hits;		 // 从节点池取得的分配次数
+	size_t misses;		 // 节点池为空、转给分配函数的次数
+	size_t cached_bytes; // 当前缓存的字节数
+} cJSON_NodePoolStats;
+
+/**
+ * @brief 启用当前线程的节点池：释放的节点和短字符串留在空闲链表中，供之后的解析和 cJSON_Create* 复用。
+ * @param max_bytes：最多缓存的字节数，超出部分直接释放。再次调用可调整上限。
+ * @note 节点池只缓存当前线程释放的内存，线程退出时自动清空。设置了线程上下文时不经过节点池。
+ *       应在 cJSON_InitHooks() 之后启用。字符串按 strlen + 1 回收，只分给同样大小的请求，
+ *       因此替换或就地截短 valuestring 不会让之后的分配拿到容量不足的块。
+ */
+void cJSON_EnableNodePool(size_t max_bytes);
+
+/**
+ * @brief 把当前线程节点池缓存的内存释放到不超过 keep_bytes。
+ * @param keep_bytes：保留的字节数，传 0 全部释放。
+ */
+void cJSON_TrimNodePool(size_t keep_bytes);
+
+/**
+ * @brief 清空并关闭当前线程的节点池。
+ */
+void cJSON_DisableNodePool(void);
+
+/**
+ * @brief 获取当前线程节点池的统计。
+ * @param stats：输出的统计。
+ */
+void cJSON_GetNodePoolStats(cJSON_NodePoolStats *stats);
+
+/* cJSON arena：以大块为单位批量分配节点和字符串，整体释放 */
+typedef struct cJSON_Arena cJSON_Arena;
+
+/**
+ * @brief 创建一个 arena。
+ * @param block_size：每个内存块的大小，传 0 使用默认值（64 KiB）。
+ * @return 成功返回 arena，失败返回 NULL。
+ */
+cJSON_Arena *cJSON_CreateArena(size_t block_size);
+
+/**
+ * @brief 重置 arena，之前从中分配的所有节点全部失效，内存块保留以供复用。
+ * @param arena：要重置的 arena。
+ * @note 若向 arena 中的树挂入了堆上分配的节点，重置前应先对根节点调用 cJSON_Delete()。
+ */
+void cJSON_ResetArena(cJSON_Arena *arena);
+
+/**
+ * @brief 释放 arena 及其所有内存块。
+ * @param arena：要释放的 arena。
+ */
+void cJSON_DeleteArena(cJSON_Arena *arena);
+
+/**
+ * @brief 将 JSON 字符串解析到 arena 中。
+ * @param arena：节点和字符串的分配来源。
+ * @param value：要解析的 JSON 字符串。
+ * @return 返回解析后的 cJSON 对象，失败返回 NULL。
+ * @note 返回的树在 arena 被重置或释放前有效。对其调用 cJSON_Delete() 只会释放后来挂入的堆节点；
+ *       cJSON_Detach* 得到的节点仍属于 arena；cJSON_Duplicate() 总是返回堆上的副本。
+ */
+cJSON *cJSON_ParseWithArena(cJSON_Arena *arena, const char *value);
+
+/**
+ * @brief 就地解析 JSON 文本：字符串在 buf 内反转义，valuestring 和 string 直接指向 buf。
+ * @param buf：可写的 JSON 文本，不需要以 \0 结尾；解析会改写其内容。
+ * @param len：文本长度，整个文本必须恰好是一个 JSON 值（允许前后空白）。
+ * @return 返回解析后的 cJSON 对象，失败返回 NULL。
+ * @note buf 必须比返回的树活得更久；cJSON_Delete() 不会释放指向 buf 的字符串，cJSON_Duplicate() 返回自有字符串的副本。
+ */
+cJSON *cJSON_ParseInSitu(char *buf, size_t len);
+
+/* cJSON_ParseWithFlags() 的选项 */
+#define cJSON_KeepNumberText 1 // 数字保留原文：输出时原样写出，不损失精度；数值在第一次读取时才转换（会写入节点，见下）
+
+/**
+ * @brief 按选项解析长度为 length 的 JSON 文本，整个文本必须恰好是一个 JSON 值（允许前后空白）。
+ * @param value：JSON 文本，不要求以 \0 结尾。
+ * @param length：文本长度。
+ * @param flags：cJSON_KeepNumberText 等选项的按位或。
+ * @return 成功返回 cJSON 对象，失败返回 NULL。
+ * @note 使用 cJSON_KeepNumberText 时数字节点带 cJSON_NumberIsRaw 标记，valuedouble 和 valueint 在调用
+ *       cJSON_GetNumberValue() 之前没有意义。cJSON_SetNumberValue() 会丢弃原文。
+ * @warning 数值在第一次读取时才转换并写回节点，cJSON_GetNumberValue() 和 cJSON_GetInt64() 因此会修改树。
+ *          多个线程同时读取同一个尚未转换的数字会产生数据竞争；要在线程间共享这样的树，
+ *          先在一个线程里把每个数字读一遍，或者解析时不用 cJSON_KeepNumberText。
+ */
+cJSON *cJSON_ParseWithFlags(const char *value, size_t length, int flags);
+
 /**
  * @brief 将 JSON 字符串解析为 cJSON 对象。
  * @param string：要解析的 JSON 字符串。
@@ -92,6 +285,42 @@ char *cJSON_PrintUnformatted(cJSON *item);
  */
 char *cJSON_PrintBuffered(cJSON *item, int prebuffer, cJSON_bool fmt);
 
+/**
+ * @brief 输出回调：写出 length 字节的 data，成功返回真，返回假会中止输出。
+ */
+typedef cJSON_bool (*cJSON_WriteCallback)(const char *data, size_t length, void *ctx);
+
+/**
+ * @brief 将 cJSON 对象流式输出到回调函数。
+ * @param item：要输出的 cJSON 对象。
+ * @param fmt：是否格式化。
+ * @param write_fn：输出回调，每次收到至多一个内部块（CJSON_WRITER_CHUNK 字节），超长的字符串片段会直接传入。
+ * @param ctx：原样传给回调的用户数据。
+ * @return 全部写出返回真；回调失败或 item 无效返回假，此时回调可能已收到部分输出。
+ * @note 只使用栈上的固定大小块，不分配堆内存，峰值内存与文档大小无关。
+ */
+cJSON_bool cJSON_PrintToWriter(cJSON *item, cJSON_bool fmt, cJSON_WriteCallback write_fn, void *ctx);
+
+/**
+ * @brief 将 cJSON 对象打印到调用者提供的缓冲区（如栈或线程局部缓冲区），全程不分配内存。
+ * @param item：要输出的 cJSON 对象。
+ * @param buffer：输出缓冲区，成功时以 \0 结尾。为 NULL 或 length 为 0 时只在 required 中返回所需的字节数。
+ * @param length：缓冲区大小（字节，含结尾的 \0）。
+ * @param fmt：是否格式化。
+ * @param required：可选，成功时写入实际使用的字节数，放不下时写入所需的字节数（均含 \0）。
+ * @return 成功返回真；缓冲区不足返回假，此时 buffer 的内容未定义。
+ */
+cJSON_bool cJSON_PrintPreallocated(cJSON *item, char *buffer, size_t length, cJSON_bool fmt, size_t *required);
+
+/**
+ * @brief 将 cJSON 对象写入文件，输出以大块直接写入，不生成完整的字符串。
+ * @param item：要输出的 cJSON 对象。
+ * @param path：文件路径，已存在时覆盖。
+ * @param fmt：是否格式化。
+ * @return 全部写出返回 cJSON_True，失败返回 cJSON_False，此时文件可能只写了一部分。
+ */
+cJSON_bool cJSON_PrintToFile(cJSON *item, const char *path, cJSON_bool fmt);
+
 /**
  * @brief 释放 cJSON 对象。
  * @param c：要释放的 cJSON 对象。
@@ -104,6 +333,7 @@ void cJSON_Delete(cJSON *c);
  * @brief 获取 cJSON 数组（或对象）中的元素个数。
  * @param array：要获取元素个数的 cJSON 对象。
  * @return 返回 cJSON 数组（或对象）中的元素个数。
+ * @note 已建立索引时为 O(1)；否则沿链表计数，元素较多时顺便建立索引。
  */
 int cJSON_GetArraySize(const cJSON *array);
 
@@ -125,10 +355,101 @@ cJSON *cJSON_GetArrayItem(const cJSON *array, int index);
  */
 cJSON *cJSON_GetObjectItem(const cJSON *object, const char *string);
 
+/**
+ * @brief 从 cJSON 对象中获取指定键的元素(区分大小写)。
+ * @param object：要获取元素的 cJSON 对象。
+ * @param string：要获取元素的键。
+ * @retval 返回第一个键与 string 完全相同的元素。
+ * @retval 若检索失败，则返回 NULL。
+ */
+cJSON *cJSON_GetObjectItemCaseSensitive(const cJSON *object, const char *string);
+
+/**
+ * @brief 读取数字节点的值。
+ * @param item：数字节点。
+ * @return 返回数值，item 不是数字时返回 NaN。
+ * @note 保留原文的数字（cJSON_NumberIsRaw）在第一次读取时才转换，结果同时存入 valuedouble 和 valueint。
+ * @warning 对这样的数字，第一次读取是写操作，不能与其他线程对同一节点的读取并发（见 cJSON_ParseWithFlags()）。
+ */
+double cJSON_GetNumberValue(const cJSON *item);
+
+/**
+ * @brief 读取数字节点的 64 位整数值。
+ * @param item：数字节点。
+ * @return 解析得到的整数（没有小数和指数部分且在 long long 范围内）或 cJSON_CreateInt64() 创建的节点返回精确值；
+ *         其余数字返回 valuedouble 的截断值，超出范围时取边界值；item 不是数字或为 NaN 时返回 0。
+ * @warning 与 cJSON_GetNumberValue() 一样，第一次读取保留原文的数字时会写入节点。
+ */
+long long cJSON_GetInt64(const cJSON *item);
+
+/**
+ * @brief 设置数字节点的值，供 cJSON_SetNumberValue() 和 cJSON_SetIntValue() 使用。
+ * @param object：数字节点。
+ * @param number：新值，valueint 取其截断值（超出 int 范围时取边界值）。
+ * @return 返回 number。节点保留的原文被丢弃。
+ */
+double cJSON_SetNumberHelper(cJSON *object, double number);
+
+/**
+ * @brief 设置数字节点的 64 位整数值，供 cJSON_SetInt64Value() 使用。
+ * @param object：数字节点。
+ * @param number：新值，valuedouble 取最接近的 double，valueint 取边界内的值。
+ * @return 返回 number。节点保留的原文被丢弃。
+ */
+long long cJSON_SetInt64Helper(cJSON *object, long long number);
+
+/* 预先计算好哈希的键，反复查找同一个键时使用 */
+typedef struct cJSON_Key {
+	const char *string;	 // 键，须在 cJSON_Key 使用期间保持有效
+	unsigned int hash;	 // 键的哈希
+} cJSON_Key;
+
+/**
+ * @brief 预先计算键的哈希。
+ * @param string：键。
+ * @return 返回准备好的键，例如 cJSON_Key k = cJSON_PrepareKey("timestamp");
+ */
+cJSON_Key cJSON_PrepareKey(const char *string);
+
+/**
+ * @brief 用准备好的键从 cJSON 对象中获取元素(区分大小写)，哈希不同的成员一次整数比较即被排除。
+ * @param object：要获取元素的 cJSON 对象。
+ * @param key：cJSON_PrepareKey() 返回的键。
+ * @retval 返回第一个键与 key 完全相同的元素。
+ * @retval 若检索失败，则返回 NULL。
+ */
+cJSON *cJSON_GetObjectItemByKey(const cJSON *object, const cJSON_Key *key);
+
+/**
+ * @brief 为对象建立成员哈希索引，之后按键查找、分离、替换均为 O(1)。
+ * @param object：要建立索引的 cJSON 对象（不能是引用）。
+ * @return 成功（或已有索引）返回真，内存不足或不是对象时返回假。
+ * @note 成员数不少于 CJSON_INDEX_LAZY_THRESHOLD 的对象会在查找时自动建立索引（arena 中的对象除外）；
+ *       多线程只读共享同一棵树时，应事先对需要的对象调用本函数。
+ *       索引由 cJSON_Add*、cJSON_Detach*、cJSON_Insert*、cJSON_Replace* 维护，
+ *       绕过这些函数直接修改 child/next 链表前须先调用 cJSON_DropObjectIndex()。
+ *       arena 中的对象建立索引后，须在重置 arena 前对根节点调用 cJSON_Delete() 释放索引。
+ */
+cJSON_bool cJSON_BuildObjectIndex(cJSON *object);
+
+/**
+ * @brief 为数组建立按位置的子节点指针表，之后 cJSON_GetArraySize/cJSON_GetArrayItem 均为 O(1)。
+ * @param array：要建立索引的 cJSON 数组（不能是引用）。
+ * @return 成功（或已有索引）返回真，内存不足或不是数组时返回假。
+ * @note 自动建立、线程安全与直接修改链表的注意事项同 cJSON_BuildObjectIndex()。
+ */
+cJSON_bool cJSON_BuildArrayIndex(cJSON *array);
+
+/**
+ * @brief 释放对象或数组的索引，之后的访问回到沿链表查找（达到阈值时会重新建立）。
+ * @param object：cJSON 对象或数组。
+ */
+void cJSON_DropObjectIndex(cJSON *object);
+
 /**
  * @brief 用于分析解析失败的情况。
  * @return 返回解析失败的位置。
- * @note 当 cJSON_Parse() 返回 NULL 时定义，当 cJSON_Parse() 成功时返回 NULL。
+ * @note 当 cJSON_Parse() 返回 NULL 时定义，当 cJSON_Parse() 成功时返回 NULL。每个线程各自记录。
  */
 const char *cJSON_GetErrorPtr(void);
 
@@ -140,6 +461,7 @@ cJSON *cJSON_CreateTrue(void);
 cJSON *cJSON_CreateFalse(void);
 cJSON *cJSON_CreateBool(cJSON_bool b);
 cJSON *cJSON_CreateNumber(double num);
+cJSON *cJSON_CreateInt64(long long num);	// 保存精确的整数值，输出时不经过 double
 cJSON *cJSON_CreateString(const char *string);
 cJSON *cJSON_CreateArray(void);
 cJSON *cJSON_CreateObject(void);
@@ -190,6 +512,202 @@ cJSON *cJSON_Duplicate(cJSON *item, cJSON_bool recurse);
  */
 cJSON *cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/**
+ * @brief 解析长度为 buffer_length 的 JSON 文本，不要求以 \0 结尾，也不会读取 value[buffer_length] 及之后的内容。
+ * @param value：JSON 文本，可以直接指向网络缓冲区或 mmap 的文件。
+ * @param buffer_length：文本长度。文本中的 \0 不再表示结束，出现在字符串中或值之间时视为错误。
+ * @return 成功返回 cJSON 对象，失败返回 NULL。
+ */
+cJSON *cJSON_ParseWithLength(const char *value, size_t buffer_length);
+
+/**
+ * @brief 同 cJSON_ParseWithLength()，带可选参数。
+ * @param value：JSON 文本。
+ * @param buffer_length：文本长度。
+ * @param return_parse_end：可选参数，若非空，解析结束后将指向最后一个已解析字符的下一个位置。
+ * @param require_null_terminated：如果为 cJSON_True，要求值之后直到 buffer_length 只有空白。
+ * @return 成功返回 cJSON 对象，失败返回 NULL。
+ */
+cJSON *cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end,
+								 cJSON_bool require_null_terminated);
+
+/**
+ * @brief 只检查 JSON 文本是否合法，不建树也不分配内存。
+ * @param value：JSON 文本，不要求以 \0 结尾。
+ * @param length：文本长度，值之后直到末尾只允许空白。
+ * @param error：可选参数，输出错误码和出错位置；合法时错误码为 cJSON_ErrorNone。
+ * @return 合法返回 cJSON_True。出错时 cJSON_GetErrorPtr() 也指向出错位置。
+ * @note 按 RFC 8259 严格检查，比 cJSON_Parse() 更严：字符串中不允许控制字符、未知转义和非法 UTF-8，
+ *       数字不允许前导 0、空的小数或指数部分，空白只能是空格、\t、\n 和 \r。
+ *       嵌套层数不超过 CJSON_NESTING_LIMIT。
+ */
+cJSON_bool cJSON_Validate(const char *value, size_t length, cJSON_Error *error);
+
+/**
+ * @brief 按需解析：只展开顶层，嵌套的数组和对象用括号匹配跳过并记下在输入中的范围，
+ *        第一次通过库函数（cJSON_GetObjectItem()、cJSON_GetArrayItem()、cJSON_GetArraySize()、
+ *        输出、复制、添加成员等）访问它的子节点时才解析那一层。
+ * @param value：JSON 文本，不要求以 \0 结尾。在树被释放或完全展开之前必须保持有效且不被修改。
+ * @param length：文本长度，值之后直到末尾只允许空白。
+ * @return 成功返回 cJSON 对象，失败返回 NULL。
+ * @note 解析时只检查括号是否成对、字符串是否结束，嵌套层中的语法错误在展开该层时才发现：
+ *       此时查询返回 NULL（或 0），cJSON_GetErrorPtr() 指向出错位置，容器保持未展开。
+ *       直接沿 ->child 遍历之前须先调用 cJSON_Materialize()。
+ * @warning 展开会修改树：查找、取大小、输出、复制等看似只读的调用也会给惰性容器挂上子节点。
+ *          多个线程同时读同一棵惰性树会产生数据竞争，共享给其他线程之前须先调用 cJSON_Materialize(root, 1)。
+ */
+cJSON *cJSON_ParseLazy(const char *value, size_t length);
+
+/**
+ * @brief 展开 cJSON_ParseLazy() 得到的惰性容器，之后可以直接访问 ->child。
+ * @param item：要展开的节点，不是惰性容器时什么也不做。
+ * @param recurse：为真时展开全部子孙，之后不再依赖输入文本。
+ * @return 成功返回 cJSON_True，遇到语法错误返回 cJSON_False（已展开的部分保留）。
+ * @note 递归展开成功之后树中不再有惰性容器，可以像普通解析得到的树一样在多个线程间只读共享。
+ */
+cJSON_bool cJSON_Materialize(cJSON *item, cJSON_bool recurse);
+
+/**
+ * @brief 解析 JSON 文件。普通文件通过 mmap 直接解析，不读入中间缓冲区。
+ * @param path：文件路径。
+ * @return 成功返回 cJSON 对象，失败返回 NULL。文件无法打开或读取时 cJSON_GetErrorPtr() 返回 NULL，
+ *         解析失败时返回出错位置之后一小段文本的副本。
+ */
+cJSON *cJSON_ParseFile(const char *path);
+
+/**
+ * @brief 同 cJSON_ParseWithOpts()，但节点和字符串从 arena 中分配。
+ * @param arena：节点和字符串的分配来源。
+ * @param value：要解析的 JSON 字符串。
+ * @param return_parse_end：可选参数，若非空，解析结束后将指向最后一个已解析字符的下一个位置。
+ * @param require_null_terminated：如果为 cJSON_True，解析器将检查 JSON 字符串是否以空字符结尾。
+ * @return 成功返回 cJSON 对象，失败返回 NULL。
+ */
+cJSON *cJSON_ParseWithArenaOpts(cJSON_Arena *arena, const char *value, const char **return_parse_end,
+								cJSON_bool require_null_terminated);
+
+/* SAX 和流式解析的返回值 */
+#define cJSON_ParseError 0		// 语法错误或内存不足，cJSON_GetErrorPtr() 指向出错位置
+#define cJSON_ParseDone 1		// 解析完成
+#define cJSON_ParseStopped (-1) // 回调返回假，解析提前结束
+#define cJSON_ParseNeedMore 2	// 流式解析：当前输入已全部消费，等待下一块
+
+/* SAX 回调：返回假会中止解析。键和字符串不以 \0 结尾，只在回调期间有效 */
+typedef struct cJSON_SaxHandler {
+	cJSON_bool (*null_value)(void *ctx);
+	cJSON_bool (*boolean)(cJSON_bool value, void *ctx);
+	cJSON_bool (*number)(double value, void *ctx);
+	cJSON_bool (*string)(const char *str, size_t length, void *ctx);
+	cJSON_bool (*start_object)(void *ctx);
+	cJSON_bool (*key)(const char *str, size_t length, void *ctx);
+	cJSON_bool (*end_object)(void *ctx);
+	cJSON_bool (*start_array)(void *ctx);
+	cJSON_bool (*end_array)(void *ctx);
+} cJSON_SaxHandler;
+
+/**
+ * @brief 以事件方式解析 JSON 文本，不建立 cJSON 树，每个值都不分配内存。
+ * @param value：JSON 文本，不需要以 \0 结尾。
+ * @param length：文本长度，根值之后只允许空白。
+ * @param handler：回调表，不关心的事件置为 NULL。
+ * @param ctx：传给每个回调的用户数据。
+ * @return cJSON_ParseDone、cJSON_ParseStopped 或 cJSON_ParseError。回调返回假之前的事件都已送出。
+ * @note 不含转义的键和字符串直接指向 value，含转义的指向一块复用的缓冲区；两者都只在回调期间有效。
+ *       嵌套深度只受内存限制，不会递归。
+ */
+int cJSON_ParseSax(const char *value, size_t length, const cJSON_SaxHandler *handler, void *ctx);
+
+/* 流式（推送式）解析：输入可以按任意边界分块送入，包括字符串、\u 转义或数字的中间 */
+typedef struct cJSON_Stream cJSON_Stream;
+
+/**
+ * @brief 创建流式解析状态。
+ * @param handler：SAX 回调；传 NULL 时建立 cJSON 树，完成后用 cJSON_StreamDetachTree() 取出。
+ * @param ctx：传给每个回调的用户数据。
+ * @return 成功返回流式解析状态，失败返回 NULL。
+ */
+cJSON_Stream *cJSON_CreateStream(const cJSON_SaxHandler *handler, void *ctx);
+
+/**
+ * @brief 送入下一块输入。
+ * @param stream：流式解析状态。
+ * @param chunk：输入块，调用返回后即可复用；只有被块的末尾截断的那个记号会被复制。
+ * @param length：块的长度。
+ * @return 根值尚未结束返回 cJSON_ParseNeedMore，已结束返回 cJSON_ParseDone（之后只允许空白），
+ *         否则返回 cJSON_ParseStopped 或 cJSON_ParseError；结束后再调用返回相同的结果。
+ * @note 出错时 cJSON_GetErrorPtr() 指向当前块或内部缓冲区，只在下一次调用前有效。
+ */
+int cJSON_StreamFeed(cJSON_Stream *stream, const char *chunk, size_t length);
+
+/**
+ * @brief 通知输入已经结束，结束末尾的数字或字面量（如根值是 123 时）。
+ * @param stream：流式解析状态。
+ * @return 根值完整返回 cJSON_ParseDone，输入被截断返回 cJSON_ParseError。
+ */
+int cJSON_StreamFinish(cJSON_Stream *stream);
+
+/**
+ * @brief 取出建树模式下解析得到的树，所有权转给调用者。
+ * @param stream：流式解析状态。
+ * @return 解析已完成时返回根节点，否则返回 NULL。
+ */
+cJSON *cJSON_StreamDetachTree(cJSON_Stream *stream);
+
+/**
+ * @brief 释放流式解析状态，以及未取出的树。
+ * @param stream：要释放的流式解析状态。
+ */
+void cJSON_DeleteStream(cJSON_Stream *stream);
+
+/* NDJSON 记录回调：record 在工作线程的 arena 中，只在回调期间有效；offset 是记录在输入中的字节偏移。返回假中止解析 */
+typedef cJSON_bool (*cJSON_RecordHandler)(cJSON *record, size_t offset, void *ctx);
+
+/**
+ * @brief 用多个线程解析 NDJSON（每行一个 JSON 值），每个线程从自己的 arena 分配。
+ * @param value：NDJSON 文本，不需要以 \0 结尾。空行被跳过，行尾的 \r 视为空白。
+ * @param length：文本长度。
+ * @param threads：线程数（包括调用线程），小于等于 0 时使用硬件线程数。
+ * @param ordered：为真时按输入顺序回调，回调不会并发；为假时解析完一条立即回调，回调可能并发且顺序不定。
+ * @param handler：记录回调。
+ * @param ctx：传给回调的用户数据。
+ * @return cJSON_ParseDone、cJSON_ParseStopped 或 cJSON_ParseError。出错时 cJSON_GetErrorPtr() 指向出错位置，
+ *         内存不足时为 NULL。
+ * @note 有序模式下，出错或中止之前的记录都已送出；无序模式下其他线程可能已送出之后的记录。
+ *       需要保留记录时用 cJSON_Duplicate() 复制。
+ */
+int cJSON_ParseNdjson(const char *value, size_t length, int threads, cJSON_bool ordered, cJSON_RecordHandler handler,
+					  void *ctx);
+
+/* 紧凑文档：只读，节点按解析顺序连续存放，每个节点 16 字节，短字符串和键内联。节点以下标引用，根节点为 0 */
+typedef struct cJSON_Doc cJSON_Doc;
+
+#define cJSON_DocNone ((size_t) -1) // 不存在的节点
+
+/**
+ * @brief 把 JSON 文本解析为紧凑文档。
+ * @param value：JSON 文本，不需要以 \0 结尾。
+ * @param length：文本长度，根值之后只允许空白。
+ * @return 成功返回文档，失败返回 NULL（语法错误时 cJSON_GetErrorPtr() 指向出错位置，内存不足时为 NULL）。
+ */
+cJSON_Doc *cJSON_ParseDoc(const char *value, size_t length);
+
+/**
+ * @brief 释放紧凑文档，之前取得的字符串随之失效。
+ * @param doc：要释放的文档。
+ */
+void cJSON_DeleteDoc(cJSON_Doc *doc);
+
+/* 访问紧凑文档，ref 无效时返回 cJSON_Invalid、0、NULL 或 cJSON_DocNone */
+int cJSON_DocType(const cJSON_Doc *doc, size_t ref);	 // cJSON_False ... cJSON_Object
+double cJSON_DocNumber(const cJSON_Doc *doc, size_t ref);
+const char *cJSON_DocString(const cJSON_Doc *doc, size_t ref, size_t *length); // 以 \0 结尾，length 可为 NULL
+const char *cJSON_DocKey(const cJSON_Doc *doc, size_t ref, size_t *length);	   // 对象成员的键
+size_t cJSON_DocSize(const cJSON_Doc *doc, size_t ref);						   // 数组或对象的成员数
+size_t cJSON_DocChild(const cJSON_Doc *doc, size_t ref);					   // 第一个成员
+size_t cJSON_DocNext(const cJSON_Doc *doc, size_t ref);						   // 下一个兄弟，跳过整棵子树
+size_t cJSON_DocGetArrayItem(const cJSON_Doc *doc, size_t ref, size_t index);
+size_t cJSON_DocGetObjectItem(const cJSON_Doc *doc, size_t ref, const char *key); // 不区分 ASCII 大小写
+
 /**
  * @brief 压缩给定的 JSON 字符串，去掉所有空白字符。
  * @param json ：要压缩的 JSON 字符串。
@@ -203,11 +721,13 @@ void cJSON_Minify(char *json);
 #define cJSON_AddFalseToObject(object, name) cJSON_AddItemToObject(object, name, cJSON_CreateFalse())
 #define cJSON_AddBoolToObject(object, name, b) cJSON_AddItemToObject(object, name, cJSON_CreateBool(b))
 #define cJSON_AddNumberToObject(object, name, n) cJSON_AddItemToObject(object, name, cJSON_CreateNumber(n))
+#define cJSON_AddInt64ToObject(object, name, n) cJSON_AddItemToObject(object, name, cJSON_CreateInt64(n))
 #define cJSON_AddStringToObject(object, name, s) cJSON_AddItemToObject(object, name, cJSON_CreateString(s))
 
 /* 当分配整数值时，也需要将其传递到双精度值 */
-#define cJSON_SetIntValue(object, val) ((object) ? (object)->valueint = (object)->valuedouble = (val) : (val))
-#define cJSON_SetNumberValue(object, val) ((object) ? (object)->valueint = (object)->valuedouble = (val) : (val))
+#define cJSON_SetIntValue(object, val) ((object) ? cJSON_SetInt64Helper(object, (long long) (val)) : (val))
+#define cJSON_SetNumberValue(object, val) ((object) ? cJSON_SetNumberHelper(object, (double) (val)) : (val))
+#define cJSON_SetInt64Value(object, val) ((object) ? cJSON_SetInt64Helper(object, (long long) (val)) : (val))
 
 
 #ifdef __cplusplus
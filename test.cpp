@@ -4,28 +4,18 @@ using namespace std;
 
 int main() {
 
-    fstream file = fstream("../.vscode/settings.json", ios::in);
-
-    if (!file.is_open()) {
-        cout << "Open file failed." << endl;
-        return -1;
-    }
-
-    string json_str;
-    string line;
-    while (getline(file, line)) {
-        json_str += line;
-    }
-
-    cout << json_str << endl;
-
-    cJSON *root = cJSON_Parse(json_str.c_str());
+    cJSON *root = cJSON_ParseFile("../.vscode/settings.json");
     if (root == nullptr) {
-        cout << "Before cJSON_Parse: " << cJSON_GetErrorPtr() << endl;
+        const char *error = cJSON_GetErrorPtr();
+        if (error == nullptr) cout << "Open file failed." << endl;
+        else cout << "Before cJSON_ParseFile: " << error << endl;
         return -1;
     }
 
-    cout << "After cJSON_Parse: " << endl << cJSON_Print(root) << endl;
+    char *text = cJSON_Print(root);
+    cout << "After cJSON_ParseFile: " << endl << text << endl;
+    free(text);
+    cJSON_Delete(root);
 
     return 0;
-}
\ No newline at end of file
+}
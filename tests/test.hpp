@@ -0,0 +1,50 @@
+/*
+ * 测试用的断言宏与公用函数。
+ * 每个测试程序用 CHECK 记录失败，main 返回 test_report() 的结果，失败时由 ctest 报告。
+ */
+#ifndef CJSON_TEST_HPP
+#define CJSON_TEST_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "cJSON.hpp"
+
+inline int test_failures = 0;
+inline int test_checks = 0;
+
+#define CHECK(cond)                                                                      \
+	do {                                                                                 \
+		test_checks++;                                                                   \
+		if (!(cond)) {                                                                   \
+			if (++test_failures <= 50) fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+		}                                                                                \
+	} while (0)
+
+/* 紧凑输出，item 为 NULL 时返回 "<null>" */
+inline std::string print_unformatted(const cJSON *item) {
+	char *text;
+	std::string out;
+	if (!item) return "<null>";
+	if (!(text = cJSON_PrintUnformatted((cJSON *) item))) return "<print failed>";
+	out = text;
+	free(text);
+	return out;
+}
+
+/* 解析后紧凑输出，解析失败时返回 "<null>" */
+inline std::string roundtrip(const std::string &json) {
+	cJSON *root = cJSON_ParseWithLength(json.data(), json.size());
+	std::string out = print_unformatted(root);
+	cJSON_Delete(root);
+	return out;
+}
+
+/* 输出统计并返回进程退出码 */
+inline int test_report(const char *name) {
+	printf("%s: %d checks, %d failed\n", name, test_checks, test_failures);
+	return test_failures ? 1 : 0;
+}
+
+#endif
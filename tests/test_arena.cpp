@@ -0,0 +1,126 @@
+/*
+ * arena：解析到 arena 的树挂入堆节点后，对根调用 cJSON_Delete 只释放堆节点，不漏也不重复释放；
+ * cJSON_Duplicate 得到的堆副本在 cJSON_ResetArena 之后仍有效；分离出的 arena 节点在重置之前有效；
+ * 重置后反复解析复用已有的内存块。通过 cJSON_InitHooks 记录未释放的块。
+ */
+#include <cstring>
+#include <set>
+#include <string>
+
+#include "test.hpp"
+
+static std::set<void *> live;     // 由分配函数分配、尚未释放的块
+
+static void *tracked_malloc(size_t size) {
+    void *ptr = malloc(size ? size : 1);
+    if (ptr) live.insert(ptr);
+    return ptr;
+}
+
+static void tracked_free(void *ptr) {
+    if (!ptr) return;
+    CHECK(live.erase(ptr) == 1);
+    free(ptr);
+}
+
+/* 紧凑输出，缓冲区来自分配函数，须由 tracked_free 释放 */
+static std::string printed(cJSON *item) {
+    char *text = cJSON_PrintUnformatted(item);
+    std::string out = text ? text : "<print failed>";
+    tracked_free(text);
+    return out;
+}
+
+static const char *document = "{\"name\":\"arena\",\"list\":[1,2,{\"k\":\"v\"}],\"obj\":{\"a\":true,\"b\":null},\"n\":3}";
+
+static void test_heap_items() {
+    cJSON_Arena *arena = cJSON_CreateArena(256);     // 小块，解析就要用到好几块
+    cJSON *root = cJSON_ParseWithArena(arena, document);
+    CHECK(root && (root->type & cJSON_IsArena));
+    const size_t blocks = live.size();
+
+    const int numbers[] = {1, 2, 3};
+    cJSON *heap = cJSON_CreateObject();
+    cJSON_AddItemToObject(heap, "s", cJSON_CreateString("heap string"));
+    cJSON_AddItemToObject(heap, "arr", cJSON_CreateIntArray(numbers, 3));
+    cJSON_AddItemToObject(root, "heap", heap);
+    cJSON_AddItemToArray(cJSON_GetObjectItem(root, "list"), cJSON_CreateString("appended"));
+    cJSON_ReplaceItemInObject(cJSON_GetObjectItem(root, "obj"), "a", cJSON_CreateString("replaced"));
+    cJSON_ReplaceItemInArray(cJSON_GetObjectItem(root, "list"), 0, cJSON_CreateNumber(10));
+    cJSON_AddItemToObject(heap, "moved", cJSON_DetachItemFromObject(root, "n"));    // arena 节点挂到堆节点下
+    cJSON_AddItemReferenceToObject(root, "ref", cJSON_GetObjectItem(root, "obj"));
+    cJSON_BuildObjectIndex(root);           // arena 中对象的索引在堆上
+    CHECK(live.size() > blocks);
+    CHECK(printed(root) == "{\"name\":\"arena\",\"list\":[10,2,{\"k\":\"v\"},\"appended\"],\"obj\":{\"a\":\"replaced\","
+                           "\"b\":null},\"heap\":{\"s\":\"heap string\",\"arr\":[1,2,3],\"moved\":3},"
+                           "\"ref\":{\"a\":\"replaced\",\"b\":null}}");
+
+    cJSON_Delete(root);
+    CHECK(live.size() == blocks);           // 只剩 arena 的块
+    cJSON_DeleteArena(arena);
+    CHECK(live.empty());
+}
+
+static void test_duplicate_outlives_reset() {
+    cJSON_Arena *arena = cJSON_CreateArena(0);
+    cJSON *root = cJSON_ParseWithArena(arena, document);
+    const std::string expected = printed(root);
+    cJSON *copy = cJSON_Duplicate(root, 1);
+    CHECK(copy && !(copy->type & cJSON_IsArena) && !(copy->child->type & cJSON_IsArena));
+    cJSON_Delete(root);
+    cJSON_ResetArena(arena);
+    root = cJSON_ParseWithArena(arena, "[\"overwrites the old nodes and strings in the same block\",0,0,0,0,0,0,0]");
+    CHECK(printed(copy) == expected);
+    cJSON_Delete(copy);
+    cJSON_Delete(root);
+    cJSON_DeleteArena(arena);
+    CHECK(live.empty());
+}
+
+static void test_detached() {
+    cJSON_Arena *arena = cJSON_CreateArena(0);
+    cJSON *root = cJSON_ParseWithArena(arena, document);
+    cJSON *list = cJSON_DetachItemFromObject(root, "list");
+    cJSON *name = cJSON_DetachItemFromObject(root, "name");
+    CHECK(list && (list->type & cJSON_IsArena) && !list->next && !list->prev);
+    cJSON_Delete(root);                     // 根已经不用了，分离出的节点仍然有效
+    CHECK(printed(list) == "[1,2,{\"k\":\"v\"}]");
+    CHECK(name && !strcmp(name->string, "name") && !strcmp(name->valuestring, "arena"));
+    cJSON_Delete(list);                     // 对 arena 节点什么也不释放
+    CHECK(name->valuestring && !strcmp(name->valuestring, "arena"));
+    cJSON_ResetArena(arena);
+    cJSON_DeleteArena(arena);
+    CHECK(live.empty());
+}
+
+static void test_reuse() {
+    cJSON_Arena *arena = cJSON_CreateArena(1024);
+    std::string json = "[";
+    for (int i = 0; i < 200; i++) json.append(i ? ",\"" : "\"").append(std::to_string(i)).append("\"");
+    json.append("]");
+    size_t blocks = 0;
+    for (int round = 0; round < 50; round++) {
+        cJSON *root = cJSON_ParseWithArena(arena, json.c_str());
+        CHECK(root && cJSON_GetArraySize(root) == 200);
+        CHECK(!strcmp(cJSON_GetArrayItem(root, 199)->valuestring, "199"));
+        CHECK(!cJSON_ParseWithArena(arena, "[1,2,"));     // 失败的解析留下的节点在重置时一起回收
+        if (!round) blocks = live.size();
+        CHECK(live.size() == blocks);       // 重置后复用原来的块，不再申请
+        cJSON_Delete(root);
+        cJSON_ResetArena(arena);
+    }
+    cJSON_DeleteArena(arena);
+    CHECK(live.empty());
+}
+
+int main() {
+    cJSON_Hooks hooks = {tracked_malloc, tracked_free};
+    cJSON_InitHooks(&hooks);
+    cJSON_DisableNodePool();        // 节点池会留住释放的节点，这里要看到每次释放
+    test_heap_items();
+    test_duplicate_outlives_reset();
+    test_detached();
+    test_reuse();
+    cJSON_InitHooks(NULL);
+    return test_report("arena");
+}
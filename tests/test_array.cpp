@@ -0,0 +1,164 @@
+/*
+ * 数组链表与位置索引：随机的插入、追加、替换、分离和删除与 std::vector 模型对照，
+ * 数组分别处于没有索引、自动建立索引和显式建立索引的状态。每步之后检查首节点的 prev 指向尾节点、
+ * next/prev 互相一致，cJSON_GetArrayItem 的每个位置都与沿 child/next 遍历一致。
+ * 对象在建立索引后做同样的分离和替换，按位置和按键的访问也都要与遍历一致。
+ */
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test.hpp"
+
+/* 沿 child/next 遍历，顺带检查链表的形状 */
+static std::vector<cJSON *> walk(const cJSON *container) {
+    std::vector<cJSON *> nodes;
+    for (cJSON *c = container->child; c; c = c->next) {
+        if (!nodes.empty()) CHECK(c->prev == nodes.back());
+        nodes.push_back(c);
+    }
+    if (!nodes.empty()) CHECK(container->child->prev == nodes.back());
+    return nodes;
+}
+
+static void check_array(const cJSON *array, const std::vector<int> &model) {
+    std::vector<cJSON *> nodes = walk(array);
+    CHECK(nodes.size() == model.size());
+    CHECK((size_t) cJSON_GetArraySize(array) == model.size());
+    for (size_t i = 0; i < nodes.size() && i < model.size(); i++) {
+        CHECK(nodes[i]->valueint == model[i]);
+        CHECK(cJSON_GetArrayItem(array, (int) i) == nodes[i]);
+    }
+    CHECK(!cJSON_GetArrayItem(array, (int) model.size()));
+}
+
+/* mode 0 随时丢掉索引，1 只靠查找时自动建立，2 随时显式建立 */
+static void test_random_array(size_t limit, int mode) {
+    std::mt19937 rng((unsigned) limit * 3 + mode);
+    std::vector<int> model;
+    cJSON *array = cJSON_CreateArray();
+    int next_value = 0;
+
+    for (int step = 0; step < 4000; step++) {
+        size_t pos = rng() % (model.size() + 3);       // 也包括末尾之后的位置
+        int which = rng() % 20 ? (int) pos : -1;        // 负数按 0 处理
+        size_t at = which < 0 ? 0 : pos;
+        int value = next_value++;
+        switch (rng() % 8) {
+        case 0:
+        case 1:
+            if (model.size() < limit) {
+                cJSON_InsertItemInArray(array, which, cJSON_CreateNumber(value));     // 超出末尾时追加
+                model.insert(model.begin() + (long) std::min(at, model.size()), value);
+            }
+            break;
+        case 2:
+            if (model.size() < limit) {
+                cJSON_AddItemToArray(array, cJSON_CreateNumber(value));
+                model.push_back(value);
+            }
+            break;
+        case 3: {
+            cJSON *replacement = cJSON_CreateNumber(value);
+            cJSON_ReplaceItemInArray(array, which, replacement);
+            if (at < model.size()) model[at] = value;
+            else cJSON_Delete(replacement);             // 位置不存在时不接管新节点
+            break;
+        }
+        case 4: {
+            cJSON *detached = cJSON_DetachItemFromArray(array, which);
+            CHECK((detached != NULL) == (at < model.size()));
+            if (detached && at < model.size()) {
+                CHECK(detached->valueint == model[at] && !detached->next && !detached->prev);
+                model.erase(model.begin() + (long) at);
+            }
+            cJSON_Delete(detached);
+            break;
+        }
+        case 5:
+            cJSON_DeleteItemFromArray(array, which);
+            if (at < model.size()) model.erase(model.begin() + (long) at);
+            break;
+        case 6:
+            if (mode == 2) CHECK(cJSON_BuildArrayIndex(array));
+            else if (mode == 0) cJSON_DropObjectIndex(array);
+            else if (!model.empty()) CHECK(cJSON_GetArrayItem(array, (int) model.size() - 1));  // 走到末尾，够长时建立索引
+            break;
+        default:
+            if (rng() % 100 == 0) {
+                cJSON_Delete(array);
+                array = cJSON_CreateArray();
+                model.clear();
+            }
+            break;
+        }
+        if (step % 5 == 0 || model.size() < 40) check_array(array, model);
+    }
+    check_array(array, model);
+    cJSON_Delete(array);
+}
+
+static std::string member_key(int id) {
+    return std::string("m").append(std::to_string(id));
+}
+
+/* 成员按顺序的 (键的编号, 值) */
+static void check_object(const cJSON *object, const std::vector<std::pair<int, int>> &model) {
+    std::vector<cJSON *> nodes = walk(object);
+    CHECK(nodes.size() == model.size());
+    for (size_t i = 0; i < nodes.size() && i < model.size(); i++) {
+        std::string key = member_key(model[i].first);
+        CHECK(key == nodes[i]->string && nodes[i]->valueint == model[i].second);
+        CHECK(cJSON_GetArrayItem(object, (int) i) == nodes[i]);
+        CHECK(cJSON_GetObjectItem(object, key.c_str()) == nodes[i]);
+    }
+}
+
+/* 建立了索引的对象上按键分离和替换，索引要跟着更新 */
+static void test_indexed_object() {
+    std::mt19937 rng(11);
+    std::vector<std::pair<int, int>> model;
+    cJSON *object = cJSON_CreateObject();
+    int next_id = 0;
+
+    for (int step = 0; step < 4000; step++) {
+        if (step % 50 == 0) CHECK(cJSON_BuildObjectIndex(object));
+        int value = (int) (rng() % 1000000);
+        size_t at = model.empty() ? 0 : rng() % model.size();
+        switch (model.size() < 20 ? 0 : rng() % 4) {
+        case 0:
+        case 1:
+            if (model.size() < 200) {
+                cJSON_AddItemToObject(object, member_key(next_id).c_str(), cJSON_CreateNumber(value));
+                model.emplace_back(next_id++, value);
+            }
+            break;
+        case 2: {
+            std::string key = member_key(model[at].first);
+            cJSON *detached = cJSON_DetachItemFromObject(object, key.c_str());
+            CHECK(detached && detached->valueint == model[at].second && !detached->next && !detached->prev);
+            cJSON_Delete(detached);
+            model.erase(model.begin() + (long) at);
+            CHECK(!cJSON_GetObjectItem(object, key.c_str()));     // 索引中也已删除
+            break;
+        }
+        default:
+            cJSON_ReplaceItemInObject(object, member_key(model[at].first).c_str(), cJSON_CreateNumber(value));
+            model[at].second = value;
+            break;
+        }
+        if (step % 5 == 0) check_object(object, model);
+    }
+    check_object(object, model);
+    cJSON_Delete(object);
+}
+
+int main() {
+    for (size_t limit : {8, 40, 300}) {
+        for (int mode = 0; mode < 3; mode++) test_random_array(limit, mode);
+    }
+    test_indexed_object();
+    return test_report("array");
+}
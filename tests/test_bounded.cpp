@@ -0,0 +1,112 @@
+/*
+ * 带长度的解析与就地解析：输入没有 \0 结尾、紧挨着不可读的内存页时，
+ * 每个前缀的解析结果都须与把同一前缀复制成 C 字符串后用 cJSON_Parse 解析的结果相同。
+ */
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define TEST_GUARD_PAGE 1
+#endif
+
+#include "test.hpp"
+
+/* 长度为 length 的缓冲区，末尾紧挨着一个不可访问的页，越界读取会立即崩溃 */
+class guarded_buffer {
+public:
+    explicit guarded_buffer(const std::string &content) {
+#ifdef TEST_GUARD_PAGE
+        size_t page = (size_t) sysconf(_SC_PAGESIZE), pages = content.size() / page + 1;
+        mapped = (pages + 1) * page;
+        base = (char *) mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        mprotect(base + pages * page, page, PROT_NONE);
+        data = base + pages * page - content.size();
+#else
+        base = data = (char *) malloc(content.size() + 1);
+#endif
+        memcpy(data, content.data(), content.size());
+    }
+    ~guarded_buffer() {
+#ifdef TEST_GUARD_PAGE
+        munmap(base, mapped);
+#else
+        free(base);
+#endif
+    }
+    char *data;
+
+private:
+    char *base;
+    size_t mapped = 0;
+};
+
+static const char *documents[] = {
+        "{\"a\":[1,2.5,-3e2,{\"b\":null}],\"c\":\"x\\ny\",\"d\":{},\"e\":[],\"f\":true,\"g\":false}",
+        "  [1,\"x\"]  ",
+        "\"\\u00e9\\ud83d\\ude00x\\n\"",
+        "{\"a\\tb\":\"\\\\\\\"\",\"c\":[\"\",\"\\u0041\"]}",
+        "[\"a string long enough to cross one or two SIMD blocks of input\", 12345678901234567890]",
+        "-0.5e-3", "123", "true", "false", "null", "[tru]", "\"abc\\", "\"abc\\u12", "{\"a\" 1}", "[1,]",
+};
+
+static void test_prefixes() {
+    for (const char *document : documents) {
+        std::string text = document;
+        for (size_t cut = 0; cut <= text.size(); cut++) {
+            std::string prefix = text.substr(0, cut);
+            guarded_buffer buffer(prefix);
+            const char *parse_end = NULL;
+            cJSON *bounded = cJSON_ParseWithLength(buffer.data, cut), *expected = cJSON_Parse(prefix.c_str());
+            CHECK(print_unformatted(bounded) == print_unformatted(expected));
+            cJSON_Delete(bounded);
+            cJSON_Delete(expected);
+
+            bounded = cJSON_ParseWithLengthOpts(buffer.data, cut, &parse_end, 1);
+            expected = cJSON_ParseWithOpts(prefix.c_str(), NULL, 1);
+            CHECK(print_unformatted(bounded) == print_unformatted(expected));
+            CHECK(!bounded || parse_end == buffer.data + cut);
+            cJSON_Delete(bounded);
+
+            cJSON *insitu = cJSON_ParseInSitu(buffer.data, cut);     // 会改写 buffer，放在最后
+            CHECK(print_unformatted(insitu) == print_unformatted(expected));
+            cJSON_Delete(insitu);
+            cJSON_Delete(expected);
+        }
+    }
+}
+
+/* 长度范围内的 \0 不是合法的 JSON */
+static void test_embedded_nul() {
+    const char string_nul[] = "[1,\"a\0b\"]", value_nul[] = "[1,\0 2]", trailing_nul[] = "[1] \0";
+    CHECK(!cJSON_ParseWithLength(string_nul, sizeof(string_nul) - 1));
+    CHECK(!cJSON_ParseWithLength(value_nul, sizeof(value_nul) - 1));
+    CHECK(!cJSON_ParseWithLengthOpts(trailing_nul, sizeof(trailing_nul) - 1, NULL, 1));
+}
+
+/* 就地解析的字符串指向输入缓冲区，复制和输出与普通解析相同 */
+static void test_insitu() {
+    std::string text = "{\"key\":\"plain\",\"esc\":\"a\\tb\\u00e9\",\"arr\":[\"x\",\"\"]}";
+    std::vector<char> buffer(text.begin(), text.end());
+    cJSON *root = cJSON_ParseInSitu(buffer.data(), buffer.size()), *copy;
+    const char *plain = cJSON_GetObjectItem(root, "key")->valuestring;
+    CHECK(plain >= buffer.data() && plain < buffer.data() + buffer.size());
+    CHECK(!strcmp(cJSON_GetObjectItem(root, "esc")->valuestring, "a\tb\xC3\xA9"));
+    copy = cJSON_Duplicate(root, 1);
+    CHECK(print_unformatted(copy) == roundtrip(text));
+    cJSON_Delete(root);
+    CHECK(print_unformatted(copy) == roundtrip(text));     // 副本不引用输入缓冲区
+    cJSON_Delete(copy);
+
+    char trailing[] = "[1] x";
+    CHECK(!cJSON_ParseInSitu(trailing, strlen(trailing)));
+}
+
+int main() {
+    test_prefixes();
+    test_embedded_nul();
+    test_insitu();
+    return test_report("bounded");
+}
@@ -0,0 +1,210 @@
+/*
+ * 上下文：解析、输出、复制、创建和删除的所有分配都经过上下文的分配器，不经过全局的分配函数，
+ * cJSON_Delete_Ctx 与 cJSON_DeleteContext 之后没有未释放的块。多行输入出错时 cJSON_GetContextError
+ * 给出错误码、字节偏移和行列号；max_length 拒绝超长的输入而恰好等长的输入照常解析。
+ * 两个线程各用自己的上下文和分配器反复解析，错误信息和分配计数互不干扰。
+ */
+#include <atomic>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "test.hpp"
+
+/* 上下文分配器的 userdata：记录未释放的块和调用次数 */
+struct tracker {
+    std::set<void *> live;
+    size_t mallocs = 0;
+    size_t frees = 0;
+    size_t bad_frees = 0;       // 释放了不是由它分配的块；线程中不能调用 CHECK，记下来之后再检查
+};
+
+static void *tracker_malloc(size_t size, void *userdata) {
+    tracker *t = (tracker *) userdata;
+    void *ptr = malloc(size ? size : 1);
+    if (ptr) {
+        t->live.insert(ptr);
+        t->mallocs++;
+    }
+    return ptr;
+}
+
+static void tracker_free(void *ptr, void *userdata) {
+    tracker *t = (tracker *) userdata;
+    if (!ptr) return;
+    t->frees++;
+    if (t->live.erase(ptr) != 1) t->bad_frees++;
+    free(ptr);
+}
+
+static std::atomic<size_t> global_calls(0);     // 全局分配函数被调用的次数
+
+static void *global_malloc(size_t size) {
+    global_calls++;
+    return malloc(size);
+}
+
+static void global_free(void *ptr) {
+    if (ptr) global_calls++;
+    free(ptr);
+}
+
+/* 紧凑输出，缓冲区由上下文的分配器分配和释放 */
+static std::string printed(cJSON_Context *ctx, cJSON *item) {
+    char *text = cJSON_PrintUnformatted_Ctx(ctx, item);
+    std::string out = text ? text : "<print failed>";
+    cJSON_Free_Ctx(ctx, text);
+    return out;
+}
+
+static const char *document = "{\"name\":\"context\",\"list\":[1,2.5,{\"k\":\"a long enough string value\"}],"
+                              "\"obj\":{\"a\":true,\"b\":null},\"s\":\"\\u00e9\\n\"}";
+
+static void test_allocator() {
+    tracker t;
+    cJSON_Allocator allocator = {tracker_malloc, tracker_free, &t};
+    cJSON_Context *ctx = cJSON_CreateContext(&allocator, NULL);
+    CHECK(ctx && t.live.size() == 1);       // 上下文本身
+    const size_t before = t.mallocs;
+
+    cJSON *root = cJSON_Parse_Ctx(ctx, document);
+    CHECK(root && cJSON_GetContextError(ctx)->code == cJSON_ErrorNone);
+    CHECK(t.mallocs > before);
+    char *text = cJSON_Print_Ctx(ctx, root);
+    CHECK(text && t.live.count(text));
+    cJSON_Free_Ctx(ctx, text);
+    CHECK(printed(ctx, root) == "{\"name\":\"context\",\"list\":[1,2.5,{\"k\":\"a long enough string value\"}],"
+                                "\"obj\":{\"a\":true,\"b\":null},\"s\":\"\xc3\xa9\\n\"}");
+
+    cJSON *copy = cJSON_Duplicate_Ctx(ctx, root, 1);
+    CHECK(copy && t.live.count(copy) && t.live.count(copy->child));
+    CHECK(printed(ctx, copy) == printed(ctx, root));
+    cJSON *items[] = {cJSON_CreateNull_Ctx(ctx), cJSON_CreateBool_Ctx(ctx, 1), cJSON_CreateNumber_Ctx(ctx, 42),
+                      cJSON_CreateString_Ctx(ctx, "created"), cJSON_CreateArray_Ctx(ctx), cJSON_CreateObject_Ctx(ctx)};
+    for (cJSON *item : items) CHECK(item && t.live.count(item));
+
+    cJSON_Context *previous = cJSON_SetThreadContext(ctx);      // 修改树时的分配也要经过上下文
+    CHECK(previous == NULL);
+    for (size_t i = 0; i < sizeof(items) / sizeof(items[0]); i++) {
+        cJSON_AddItemToObject(copy, std::string("item").append(std::to_string(i)).c_str(), items[i]);
+    }
+    cJSON_SetThreadContext(previous);
+    CHECK(printed(ctx, cJSON_GetObjectItem(copy, "item3")) == "\"created\"");
+
+    CHECK(!cJSON_Parse_Ctx(ctx, "{\"a\":[1,2,{\"b\":\"unterminated"));     // 失败的解析释放已建立的部分
+    cJSON_Delete_Ctx(ctx, copy);
+    cJSON_Delete_Ctx(ctx, root);
+    CHECK(t.live.size() == 1);
+    cJSON_DeleteContext(ctx);
+    CHECK(t.live.empty() && t.bad_frees == 0 && t.mallocs == t.frees);
+    CHECK(global_calls == 0);
+}
+
+static void test_error_location() {
+    cJSON_Context *ctx = cJSON_CreateContext(NULL, NULL);
+    const char *text = "{\n  \"a\": 1,\n  \"b\": [true, fals]\n}";
+    CHECK(!cJSON_Parse_Ctx(ctx, text));
+    const cJSON_Error *error = cJSON_GetContextError(ctx);
+    const char *at = strstr(text, "fals");
+    CHECK(error->code == cJSON_ErrorSyntax);
+    CHECK(cJSON_GetErrorPtr() == at);
+    CHECK(error->offset == (size_t) (at - text));
+    CHECK(error->line == 3 && error->column == 15);
+
+    CHECK(!cJSON_Parse_Ctx(ctx, "[1,\n2,\n\n  3,"));     // 出错位置在末尾
+    CHECK(error->code == cJSON_ErrorSyntax && error->offset == 12 && error->line == 4 && error->column == 5);
+    CHECK(!cJSON_ParseWithLengthOpts_Ctx(ctx, "[1]\n x", 6, NULL, 1));     // 值之后多出的文本
+    CHECK(error->code == cJSON_ErrorSyntax && error->offset == 5 && error->line == 2 && error->column == 2);
+
+    cJSON *root = cJSON_Parse_Ctx(ctx, "[1]");      // 成功的解析清除上一次的错误
+    CHECK(root && error->code == cJSON_ErrorNone && !error->offset && !error->line && !error->column);
+    cJSON_Delete_Ctx(ctx, root);
+    cJSON_DeleteContext(ctx);
+    CHECK(global_calls > 0);            // 没有指定分配器的上下文使用全局的分配函数
+}
+
+static void test_max_length() {
+    const std::string text = "{\"key\":[1,2,3]}";
+    cJSON_Limits limits = {CJSON_NESTING_LIMIT, text.size()};
+    cJSON_Context *ctx = cJSON_CreateContext(NULL, &limits);
+    const cJSON_Error *error = cJSON_GetContextError(ctx);
+
+    cJSON *root = cJSON_ParseWithLengthOpts_Ctx(ctx, text.data(), text.size(), NULL, 1);
+    CHECK(root && error->code == cJSON_ErrorNone);
+    cJSON_Delete_Ctx(ctx, root);
+    std::string longer = std::string(text).append(" ");     // 只多一个空白也超过限制
+    CHECK(!cJSON_ParseWithLengthOpts_Ctx(ctx, longer.data(), longer.size(), NULL, 1));
+    CHECK(error->code == cJSON_ErrorLength && error->offset == text.size());
+    CHECK(!cJSON_Parse_Ctx(ctx, "[\"this text is longer than the limit\"]"));
+    CHECK(error->code == cJSON_ErrorLength);
+    root = cJSON_Parse_Ctx(ctx, "[\"short\"]");
+    CHECK(root && error->code == cJSON_ErrorNone);
+    cJSON_Delete_Ctx(ctx, root);
+    cJSON_DeleteContext(ctx);
+
+    root = cJSON_ParseWithLength(longer.data(), longer.size());        // 限制只作用于这个上下文
+    CHECK(root != NULL);
+    cJSON_Delete(root);
+}
+
+/* 每个线程的结果，在主线程中检查 */
+struct worker {
+    tracker t;
+    bool valid;                 // 解析正确的文本还是出错的文本
+    size_t parsed = 0;
+    size_t failures = 0;        // 结果与预期不符的次数
+};
+
+static void run_worker(worker *w) {
+    cJSON_Allocator allocator = {tracker_malloc, tracker_free, &w->t};
+    cJSON_Limits limits = {CJSON_NESTING_LIMIT, 0};
+    cJSON_Context *ctx = cJSON_CreateContext(&allocator, &limits);
+    const cJSON_Error *error = cJSON_GetContextError(ctx);
+    const std::string bad = "[1,\n 2,\n @]";
+    for (int i = 0; i < 2000; i++) {
+        if (w->valid) {
+            std::string text = std::string("{\"i\":").append(std::to_string(i)).append(",\"list\":[true,\"x\"]}");
+            cJSON *root = cJSON_Parse_Ctx(ctx, text.c_str());
+            char *out = root ? cJSON_PrintUnformatted_Ctx(ctx, root) : NULL;
+            if (!out || text != out || error->code != cJSON_ErrorNone) w->failures++;
+            else w->parsed++;
+            cJSON_Free_Ctx(ctx, out);
+            cJSON_Delete_Ctx(ctx, root);
+        } else {
+            cJSON *root = cJSON_Parse_Ctx(ctx, bad.c_str());
+            if (root || error->code != cJSON_ErrorSyntax || error->line != 3 || error->column != 2) w->failures++;
+            else w->parsed++;
+            cJSON_Delete_Ctx(ctx, root);
+        }
+        if (!w->valid && w->t.live.size() != 1) w->failures++;     // 失败的解析不留下块
+    }
+    cJSON_DeleteContext(ctx);
+}
+
+static void test_threads() {
+    worker good, bad;
+    good.valid = true;
+    bad.valid = false;
+    std::thread first(run_worker, &good);
+    std::thread second(run_worker, &bad);
+    first.join();
+    second.join();
+    for (worker *w : {&good, &bad}) {
+        CHECK(w->failures == 0 && w->parsed == 2000);
+        CHECK(w->t.live.empty() && w->t.bad_frees == 0 && w->t.mallocs == w->t.frees);
+    }
+    CHECK(good.t.mallocs > bad.t.mallocs);
+    CHECK(global_calls == 0);
+}
+
+int main() {
+    cJSON_Hooks hooks = {global_malloc, global_free};
+    cJSON_InitHooks(&hooks);
+    test_allocator();
+    test_threads();
+    test_error_location();
+    test_max_length();
+    cJSON_InitHooks(NULL);
+    return test_report("context");
+}
@@ -0,0 +1,129 @@
+/*
+ * 嵌套层数：默认限制 CJSON_NESTING_LIMIT 层，正好到限制时接受，多一层拒绝；上下文可以改变或取消限制。
+ * 不限制层数时，深度一百万的树的解析、输出、复制和释放都在 256 KB 栈的线程里完成，
+ * 用来确认这些操作不随深度递归。
+ */
+#include <pthread.h>
+
+#include <cstring>
+#include <string>
+
+#include "test.hpp"
+
+static std::string nested_arrays(size_t depth) {
+    return std::string(depth, '[') + std::string(depth, ']');
+}
+
+/* depth 层对象，最里层是 {} */
+static std::string nested_objects(size_t depth) {
+    std::string json;
+    for (size_t i = 1; i < depth; i++) json += "{\"k\":";
+    return json + "{}" + std::string(depth - 1, '}');
+}
+
+static cJSON_bool validates(const std::string &json, int *code) {
+    cJSON_Error error;
+    cJSON_bool ok = cJSON_Validate(json.data(), json.size(), &error);
+    *code = error.code;
+    return ok;
+}
+
+static void test_default_limit() {
+    int code;
+    for (const std::string &json : {nested_arrays(CJSON_NESTING_LIMIT), nested_objects(CJSON_NESTING_LIMIT)}) {
+        cJSON *root = cJSON_ParseWithLength(json.data(), json.size());
+        CHECK(root != NULL);
+        CHECK(print_unformatted(root) == json);
+        cJSON_Delete(root);
+        CHECK(validates(json, &code) && code == cJSON_ErrorNone);
+    }
+    for (const std::string &json : {nested_arrays(CJSON_NESTING_LIMIT + 1), nested_objects(CJSON_NESTING_LIMIT + 1)}) {
+        CHECK(!cJSON_ParseWithLength(json.data(), json.size()));
+        CHECK(!validates(json, &code) && code == cJSON_ErrorDepth);
+    }
+}
+
+static void test_context_limit() {
+    cJSON_Limits limits = {10, 0};
+    cJSON_Context *ctx = cJSON_CreateContext(NULL, &limits);
+    std::string json = nested_arrays(10);
+    cJSON *root = cJSON_ParseWithLengthOpts_Ctx(ctx, json.data(), json.size(), NULL, 0);
+    CHECK(root != NULL);
+    CHECK(cJSON_GetContextError(ctx)->code == cJSON_ErrorNone);
+    cJSON_Delete_Ctx(ctx, root);
+    json = nested_arrays(11);
+    CHECK(!cJSON_ParseWithLengthOpts_Ctx(ctx, json.data(), json.size(), NULL, 0));
+    CHECK(cJSON_GetContextError(ctx)->code == cJSON_ErrorDepth);
+    CHECK(cJSON_GetContextError(ctx)->offset == 10);     // 第 11 个 [
+    cJSON_DeleteContext(ctx);
+
+    limits.max_depth = 5000;                            // 放宽到默认限制以上
+    ctx = cJSON_CreateContext(NULL, &limits);
+    json = nested_objects(5000);
+    root = cJSON_ParseWithLengthOpts_Ctx(ctx, json.data(), json.size(), NULL, 0);
+    CHECK(root != NULL);
+    cJSON_Delete_Ctx(ctx, root);
+    json = nested_objects(5001);
+    CHECK(!cJSON_ParseWithLengthOpts_Ctx(ctx, json.data(), json.size(), NULL, 0));
+    CHECK(cJSON_GetContextError(ctx)->code == cJSON_ErrorDepth);
+    cJSON_DeleteContext(ctx);
+}
+
+/* 深度一百万：解析、输出、复制、释放，以及用 API 逐层建立的链。带缩进的输出长度与深度的平方成正比，只用三千层 */
+static void *deep_operations(void *) {
+    const size_t depth = 1000000;
+    cJSON_Limits limits = {0, 0};
+    cJSON_Context *ctx = cJSON_CreateContext(NULL, &limits);
+    for (const std::string &json : {nested_arrays(depth), nested_objects(depth)}) {
+        cJSON *root = cJSON_ParseWithLengthOpts_Ctx(ctx, json.data(), json.size(), NULL, 0);
+        CHECK(root != NULL);
+        if (!root) continue;
+        char *text = cJSON_PrintUnformatted_Ctx(ctx, root);
+        CHECK(text && text == json);
+        cJSON_Free_Ctx(ctx, text);
+        cJSON *copy = cJSON_Duplicate_Ctx(ctx, root, 1);
+        CHECK(copy != NULL);
+        text = cJSON_PrintUnformatted_Ctx(ctx, copy);
+        CHECK(text && text == json);
+        cJSON_Free_Ctx(ctx, text);
+        cJSON_Delete_Ctx(ctx, copy);
+        cJSON_Delete_Ctx(ctx, root);
+    }
+    std::string json = nested_objects(3000);
+    cJSON *root = cJSON_ParseWithLengthOpts_Ctx(ctx, json.data(), json.size(), NULL, 0);
+    char *text = cJSON_Print_Ctx(ctx, root);
+    CHECK(text && strlen(text) > 3000 * 3000 / 2);
+    cJSON_Free_Ctx(ctx, text);
+    cJSON_Delete_Ctx(ctx, root);
+    cJSON_DeleteContext(ctx);
+
+    root = cJSON_CreateArray();
+    cJSON *inner = root;
+    for (size_t i = 1; i < depth; i++) {
+        cJSON *child = cJSON_CreateArray();
+        cJSON_AddItemToArray(inner, child);
+        inner = child;
+    }
+    cJSON *copy = cJSON_Duplicate(root, 1);
+    CHECK(print_unformatted(copy) == nested_arrays(depth));
+    cJSON_Delete(copy);
+    cJSON_Delete(root);
+    return NULL;
+}
+
+static void test_small_stack() {
+    pthread_attr_t attr;
+    pthread_t thread;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 256 * 1024);
+    CHECK(pthread_create(&thread, &attr, deep_operations, NULL) == 0);
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+}
+
+int main() {
+    test_default_limit();
+    test_context_limit();
+    test_small_stack();
+    return test_report("depth");
+}
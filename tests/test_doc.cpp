@@ -0,0 +1,144 @@
+/*
+ * 紧凑文档：把文档转回 cJSON 树后输出，须与直接解析的结果相同。
+ * 节点数组按输入中 , : [ { 的个数一次分配，输入里这些字符集中在字符串中或完全没有时都要正确。
+ */
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+/* 把文档中 ref 处的值转成 cJSON 树 */
+static cJSON *to_tree(const cJSON_Doc *doc, size_t ref) {
+    cJSON *item = NULL;
+    size_t length;
+    const char *str;
+    switch (cJSON_DocType(doc, ref)) {
+    case cJSON_False: return cJSON_CreateFalse();
+    case cJSON_True: return cJSON_CreateTrue();
+    case cJSON_NULL: return cJSON_CreateNull();
+    case cJSON_Number: return cJSON_CreateNumber(cJSON_DocNumber(doc, ref));
+    case cJSON_String:
+        str = cJSON_DocString(doc, ref, &length);
+        CHECK(strlen(str) == length);
+        return cJSON_CreateString(str);
+    case cJSON_Array:
+        item = cJSON_CreateArray();
+        for (size_t child = cJSON_DocChild(doc, ref); child != cJSON_DocNone; child = cJSON_DocNext(doc, child))
+            cJSON_AddItemToArray(item, to_tree(doc, child));
+        CHECK((size_t) cJSON_GetArraySize(item) == cJSON_DocSize(doc, ref));
+        return item;
+    case cJSON_Object:
+        item = cJSON_CreateObject();
+        for (size_t child = cJSON_DocChild(doc, ref); child != cJSON_DocNone; child = cJSON_DocNext(doc, child))
+            cJSON_AddItemToObject(item, cJSON_DocKey(doc, child, NULL), to_tree(doc, child));
+        CHECK((size_t) cJSON_GetArraySize(item) == cJSON_DocSize(doc, ref));
+        return item;
+    default:
+        return NULL;
+    }
+}
+
+static void check_doc(const std::string &json) {
+    cJSON_Doc *doc = cJSON_ParseDoc(json.data(), json.size());
+    cJSON *tree = to_tree(doc, 0);
+    std::string expected = roundtrip(json);
+    CHECK(print_unformatted(tree) == expected);
+    if (print_unformatted(tree) != expected) fprintf(stderr, "  input: %s\n", json.c_str());
+    cJSON_Delete(tree);
+    cJSON_DeleteDoc(doc);
+}
+
+static void test_shapes() {
+    const char *cases[] = {
+            "0", "\"\"", "\"short\"", "\"a string longer than seven bytes\"", "true", "null", "[]", "{}", "[[]]", "[{}]",
+            "{\"a\":{}}", "[1,2,3]", "{\"k\":[1,{\"x\":null}],\"longer key name\":\"v\"}", "[[[[[[1]]]]]]",
+            "[\",,,,::::[[[[{{{{\",\"{\",\"[\"]", "{\"{[,:\":\":,[{\"}", "[\"\\u0041\\n\\\"\"]",
+            "  [ 1 , 2 ]  ", "{\"a\":1,\"b\":2,\"a\":3}",
+    };
+    for (const char *json : cases) check_doc(json);
+}
+
+static void test_sizes() {
+    // 同一个值在数组中重复 n 次，检查节点数组正好写满上界附近时的情况
+    for (const char *value : {"1", "{}", "[]", "\"s\"", "{\"k\":\"v\"}", "[1,[2]]"}) {
+        std::string json = "[";
+        for (int n = 0; n < 300; n++) {
+            check_doc(json + "]");
+            json.append(n ? "," : "").append(value);
+        }
+    }
+}
+
+static void test_random() {
+    std::mt19937 rng(20);
+    for (int round = 0; round < 200; round++) {
+        std::string json;
+        int depth = 0;
+        bool need_value = true, in_object = false;
+        std::string stack;
+        while (true) {
+            if (need_value) {
+                switch (rng() % 6) {
+                case 0: json += std::to_string((int) (rng() % 2000) - 1000); break;
+                case 1: json.append("\"").append(rng() % 20, (char) ('a' + rng() % 3)).append(rng() % 2 ? ",:[{" : "").append("\""); break;
+                case 2: json += "null"; break;
+                case 3:
+                    if (depth < 8) {
+                        json += '[';
+                        stack += ']';
+                        depth++;
+                        if (rng() % 4 == 0) {
+                            json += ']';
+                            stack.pop_back();
+                            depth--;
+                        } else continue;
+                    } else json += "true";
+                    break;
+                default:
+                    if (depth < 8) {
+                        json += '{';
+                        stack += '}';
+                        depth++;
+                        if (rng() % 4 == 0) {
+                            json += '}';
+                            stack.pop_back();
+                            depth--;
+                            break;
+                        }
+                        json.append("\"k").append(std::to_string(rng() % 100)).append("\":");
+                        continue;
+                    }
+                    json += "false";
+                    break;
+                }
+                need_value = false;
+            }
+            if (stack.empty()) break;
+            in_object = stack.back() == '}';
+            if (rng() % 3 == 0) {
+                json += stack.back();
+                stack.pop_back();
+                depth--;
+                continue;
+            }
+            json += ',';
+            if (in_object) json.append("\"k").append(std::to_string(rng() % 100)).append("\":");
+            need_value = true;
+        }
+        check_doc(json);
+    }
+}
+
+static void test_errors() {
+    for (const char *json : {"", "[", "[1,]", "{\"a\"}", "[1] x", "\"unterminated"}) CHECK(!cJSON_ParseDoc(json, strlen(json)));
+    CHECK(!cJSON_ParseDoc(NULL, 0));
+}
+
+int main() {
+    test_shapes();
+    test_sizes();
+    test_random();
+    test_errors();
+    return test_report("doc");
+}
@@ -0,0 +1,108 @@
+/*
+ * 文件输入输出：cJSON_PrintToFile 带缩进和不带缩进的输出与 cJSON_Print 逐字节相同，包括超过一个
+ * CJSON_FILE_CHUNK（64 KiB）写入块的输出；cJSON_ParseFile 读回的树相同。空文件、不存在的路径和目录
+ * 都返回 NULL，无法读取时 cJSON_GetErrorPtr() 为 NULL；语法错误时它指向映射解除前复制出的出错位置之后的文本。
+ */
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "test.hpp"
+
+static std::string dir;
+
+static std::string path_of(const char *name) {
+    return std::string(dir).append("/").append(name);
+}
+
+static std::string read_back(const std::string &path) {
+    std::string out;
+    char buf[4096];
+    size_t n;
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) return "<missing>";
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) out.append(buf, n);
+    fclose(file);
+    return out;
+}
+
+static void write_file(const std::string &path, const std::string &text) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) return;
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+}
+
+/* records 条记录的数组，紧凑输出约 90 * records 字节 */
+static std::string make_document(size_t records) {
+    std::string json = "[";
+    for (size_t i = 0; i < records; i++) {
+        json.append(i ? "," : "").append("{\"id\":").append(std::to_string(i)).append(",\"name\":\"item ");
+        json.append(std::to_string(i * 7919 % 10007)).append("\",\"tags\":[\"a\",\"b\"],\"pos\":{\"x\":1.5,\"y\":-2}}");
+    }
+    return json.append("]");
+}
+
+static void test_roundtrip() {
+    const std::string path = path_of("out.json");
+    for (size_t records : {(size_t) 0, (size_t) 3, (size_t) 5000}) {     // 5000 条记录紧凑输出也超过 64 KiB 的写入块
+        std::string json = make_document(records);
+        cJSON *root = cJSON_ParseWithLength(json.data(), json.size());
+        for (int fmt = 0; fmt < 2; fmt++) {
+            char *expected = fmt ? cJSON_Print(root) : cJSON_PrintUnformatted(root);
+            CHECK(cJSON_PrintToFile(root, path.c_str(), fmt));
+            std::string written = read_back(path);
+            CHECK(written == expected);
+            if (records == 5000) CHECK(written.size() > 64 * 1024);
+            cJSON *back = cJSON_ParseFile(path.c_str());
+            CHECK(back != NULL && cJSON_GetErrorPtr() == NULL);
+            CHECK(print_unformatted(back) == print_unformatted(root));
+            cJSON_Delete(back);
+            free(expected);
+        }
+        cJSON_Delete(root);
+    }
+    CHECK(!cJSON_PrintToFile(NULL, path.c_str(), 0));
+    cJSON *item = cJSON_CreateTrue();
+    CHECK(!cJSON_PrintToFile(item, path_of("no/such/dir.json").c_str(), 0));
+    cJSON_Delete(item);
+}
+
+static void test_unreadable() {
+    write_file(path_of("empty.json"), "");
+    CHECK(!cJSON_ParseFile(path_of("empty.json").c_str()));
+    CHECK(cJSON_GetErrorPtr() && !*cJSON_GetErrorPtr());         // 空文本是语法错误，出错位置在末尾
+    CHECK(!cJSON_Parse("[1") && cJSON_GetErrorPtr());             // 先留下一个出错位置
+    CHECK(!cJSON_ParseFile(path_of("missing.json").c_str()));
+    CHECK(cJSON_GetErrorPtr() == NULL);
+    CHECK(!cJSON_ParseFile(dir.c_str()));                         // 目录能打开但读不出内容
+    CHECK(cJSON_GetErrorPtr() == NULL);
+    CHECK(!cJSON_ParseFile(NULL) && cJSON_GetErrorPtr() == NULL);
+}
+
+static void test_syntax_error() {
+    std::string big = make_document(2000);
+    big[big.size() / 2] = '@';     // 出错位置之后还有很长的文本，复制的部分被截短
+    for (const std::string &text : {std::string("{\"a\":1,\"b\":tru}"), std::string("[1,2,"), big}) {
+        const std::string path = path_of("bad.json");
+        write_file(path, text);
+        CHECK(!cJSON_ParseWithLength(text.data(), text.size()));
+        std::string expected = text.substr((size_t) (cJSON_GetErrorPtr() - text.data()), 63);
+        CHECK(!cJSON_ParseFile(path.c_str()));
+        CHECK(cJSON_GetErrorPtr() && expected == cJSON_GetErrorPtr());
+    }
+}
+
+int main() {
+    char templ[] = "/tmp/cjson_test_file_XXXXXX";
+    if (!mkdtemp(templ)) return 1;
+    dir = templ;
+    test_roundtrip();
+    test_unreadable();
+    test_syntax_error();
+    for (const char *name : {"out.json", "empty.json", "bad.json"}) unlink(path_of(name).c_str());
+    rmdir(dir.c_str());
+    return test_report("file");
+}
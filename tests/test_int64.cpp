@@ -0,0 +1,138 @@
+/*
+ * 64 位整数：整数直接从数字解析为 valueint64，输出时不经过 double；
+ * 超出 long long 范围的整数、小数和指数写法退回 double。修改数值的各种途径都要让整数值保持一致或作废。
+ */
+#include <climits>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+static long long int64_of(const cJSON *object, const char *name) {
+    return cJSON_GetInt64(cJSON_GetObjectItem(object, name));
+}
+
+static void test_roundtrip() {
+    CHECK(roundtrip("[9223372036854775807,-9223372036854775808]") == "[9223372036854775807,-9223372036854775808]");
+    CHECK(roundtrip("[9007199254740991,9007199254740992,9007199254740993]") ==
+          "[9007199254740991,9007199254740992,9007199254740993]");    // 2^53 - 1、2^53、2^53 + 1
+    CHECK(roundtrip("[-9007199254740993]") == "[-9007199254740993]");
+    CHECK(roundtrip("[9223372036854775808]") == "[9223372036854776000]");     // 2^63 溢出，退回 double
+    CHECK(roundtrip("[-9223372036854775809]") == "[-9223372036854776000]");
+    CHECK(roundtrip("[-0,0,1.0,1e2,12345678901234567890]") == "[-0,0,1,100,12345678901234567000]");
+}
+
+static void test_accessors() {
+    cJSON *root = cJSON_Parse("{\"id\":1234567890123456789,\"neg\":-9223372036854775808,\"max\":9223372036854775807,"
+                              "\"big\":1e30,\"f\":2.9,\"s\":\"x\",\"m\":-0,\"p53\":9007199254740993}");
+    CHECK(int64_of(root, "id") == 1234567890123456789LL);
+    CHECK(int64_of(root, "neg") == LLONG_MIN);
+    CHECK(int64_of(root, "max") == LLONG_MAX);
+    CHECK(int64_of(root, "big") == LLONG_MAX);      // 超出范围的 double 取边界值
+    CHECK(int64_of(root, "f") == 2);
+    CHECK(int64_of(root, "s") == 0);
+    CHECK(int64_of(root, "p53") == 9007199254740993LL);
+    CHECK(cJSON_GetObjectItem(root, "p53")->valuedouble == 9007199254740992.0);     // 最接近的 double
+    CHECK(cJSON_GetObjectItem(root, "id")->valueint == INT_MAX);
+    CHECK(cJSON_GetObjectItem(root, "neg")->valueint == INT_MIN);
+    CHECK(!(cJSON_GetObjectItem(root, "m")->type & cJSON_NumberIsInt64));   // -0 不是整数，否则会丢掉符号
+    CHECK(cJSON_GetInt64(NULL) == 0);
+    cJSON_Delete(root);
+}
+
+static void test_modify() {
+    cJSON *root = cJSON_Parse("{\"id\":1234567890123456789,\"neg\":-9223372036854775808,\"f\":2.9,\"m\":-0}");
+    cJSON *copy = cJSON_Duplicate(root, 1);
+    CHECK(int64_of(copy, "id") == 1234567890123456789LL);
+    CHECK(int64_of(copy, "neg") == LLONG_MIN);
+    cJSON_SetNumberValue(cJSON_GetObjectItem(copy, "id"), 5.5);
+    CHECK(int64_of(copy, "id") == 5);
+    cJSON_SetInt64Value(cJSON_GetObjectItem(copy, "f"), 9007199254740995LL);
+    CHECK(int64_of(copy, "f") == 9007199254740995LL);
+    cJSON_GetObjectItem(copy, "neg")->valuedouble = 3;     // 直接修改 valuedouble，整数值作废
+    CHECK(int64_of(copy, "neg") == 3);
+    cJSON_AddInt64ToObject(copy, "new", -9007199254740995LL);
+    CHECK(print_unformatted(copy) == "{\"id\":5.5,\"neg\":3,\"f\":9007199254740995,\"m\":-0,\"new\":-9007199254740995}");
+    CHECK(print_unformatted(root) == "{\"id\":1234567890123456789,\"neg\":-9223372036854775808,\"f\":2.9,\"m\":-0}");
+    cJSON_Delete(copy);
+    cJSON_Delete(root);
+}
+
+/* cJSON_SetIntValue 走整数路径，超过 2^53 的值不经过 double */
+static void test_set_int() {
+    cJSON *item = cJSON_CreateNumber(1.5);
+    cJSON_SetIntValue(item, 9007199254740993LL);
+    CHECK(cJSON_GetInt64(item) == 9007199254740993LL && (item->type & cJSON_NumberIsInt64));
+    CHECK(print_unformatted(item) == "9007199254740993");
+    CHECK(cJSON_SetIntValue(item, -7) == -7 && item->valueint == -7 && item->valuedouble == -7.0);
+    CHECK(cJSON_SetIntValue((cJSON *) NULL, 3) == 3);
+    cJSON_Delete(item);
+}
+
+/* 流式建树的整数与一次性解析相同，数字被块的边界切开也一样 */
+static void test_stream_tree() {
+    const std::string json = "{\"id\":9007199254740993,\"neg\":-9223372036854775808,\"max\":9223372036854775807,"
+                             "\"list\":[1234567890123456789,-0,2.5,9223372036854775808]}";
+    const std::string expected = roundtrip(json);
+    CHECK(expected == "{\"id\":9007199254740993,\"neg\":-9223372036854775808,\"max\":9223372036854775807,"
+                      "\"list\":[1234567890123456789,-0,2.5,9223372036854776000]}");
+    for (size_t cut = 1; cut < json.size(); cut++) {
+        cJSON_Stream *stream = cJSON_CreateStream(NULL, NULL);
+        CHECK(cJSON_StreamFeed(stream, json.data(), cut) == cJSON_ParseNeedMore);
+        CHECK(cJSON_StreamFeed(stream, json.data() + cut, json.size() - cut) == cJSON_ParseDone);
+        cJSON *root = cJSON_StreamDetachTree(stream);
+        CHECK(int64_of(root, "id") == 9007199254740993LL && int64_of(root, "neg") == LLONG_MIN);
+        CHECK(print_unformatted(root) == expected);
+        cJSON_Delete(root);
+        cJSON_DeleteStream(stream);
+    }
+    cJSON_Stream *stream = cJSON_CreateStream(NULL, NULL);      // 根值就是整数，由 cJSON_StreamFinish 结束
+    CHECK(cJSON_StreamFeed(stream, "-9007199254740993", 17) == cJSON_ParseNeedMore);
+    CHECK(cJSON_StreamFinish(stream) == cJSON_ParseDone);
+    cJSON *root = cJSON_StreamDetachTree(stream);
+    CHECK(cJSON_GetInt64(root) == -9007199254740993LL);
+    cJSON_Delete(root);
+    cJSON_DeleteStream(stream);
+}
+
+static void test_number_text() {
+    const std::string json = "[18446744073709551615,9007199254740993]";
+    cJSON *root = cJSON_ParseWithFlags(json.data(), json.size(), cJSON_KeepNumberText);
+    CHECK(cJSON_GetInt64(cJSON_GetArrayItem(root, 1)) == 9007199254740993LL);
+    CHECK(cJSON_GetInt64(cJSON_GetArrayItem(root, 0)) == LLONG_MAX);
+    cJSON_SetInt64Value(cJSON_GetArrayItem(root, 0), 7);
+    CHECK(print_unformatted(root) == "[7,9007199254740993]");
+    cJSON_Delete(root);
+}
+
+static void test_random() {
+    std::mt19937_64 rng(25);
+    char buf[32];
+    for (int n = 0; n < 200000; n++) {
+        long long value = (long long) (rng() >> (rng() % 64));     // 各种位数
+        if (n % 3 == 0) value = -value;
+        if (n == 0) value = LLONG_MIN;
+        if (n == 1) value = LLONG_MAX;
+        snprintf(buf, sizeof(buf), "%lld", value);
+        cJSON *item = cJSON_Parse(buf);
+        CHECK(item && cJSON_GetInt64(item) == value);
+        CHECK(print_unformatted(item) == buf);
+        cJSON_Delete(item);
+        item = cJSON_CreateInt64(value);
+        CHECK(cJSON_GetInt64(item) == value);
+        CHECK(print_unformatted(item) == buf);
+        cJSON_Delete(item);
+    }
+}
+
+int main() {
+    test_roundtrip();
+    test_accessors();
+    test_modify();
+    test_set_int();
+    test_stream_tree();
+    test_number_text();
+    test_random();
+    return test_report("int64");
+}
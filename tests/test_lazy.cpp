@@ -0,0 +1,173 @@
+/*
+ * 按需解析（cJSON_ParseLazy）：查找只展开走过的那条路径；嵌套层的语法错误在展开时报告，容器保持惰性；
+ * 字符串中的括号和转义落在 lazy_skip 的 16 字节块的每个位置上都不影响括号匹配；
+ * 完全展开、输出、复制和添加成员的结果与 cJSON_Parse 相同。
+ */
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+static cJSON *parse_lazy(const std::string &json) {
+    return cJSON_ParseLazy(json.data(), json.size());
+}
+
+static bool is_lazy(const cJSON *item) {
+    return item && (item->type & cJSON_IsLazy);
+}
+
+/* 树中没有惰性容器 */
+static bool fully_expanded(const cJSON *item) {
+    for (; item; item = item->next) {
+        if (is_lazy(item) || !fully_expanded(item->child)) return false;
+    }
+    return true;
+}
+
+static void test_path_only() {
+    const std::string json = "{\"a\":{\"x\":[1,[2]],\"y\":{\"z\":3}},\"b\":{\"c\":[4]},\"d\":[5,{\"e\":6}]}";
+    cJSON *root = parse_lazy(json);
+    CHECK(root && !is_lazy(root));      // 顶层立即展开
+    cJSON *a = cJSON_GetObjectItem(root, "a");
+    CHECK(is_lazy(a) && !a->child);
+    cJSON *x = cJSON_GetObjectItem(a, "x");
+    CHECK(!is_lazy(a) && is_lazy(x));
+    CHECK(is_lazy(cJSON_GetObjectItem(a, "y")));
+    CHECK(is_lazy(cJSON_GetObjectItem(root, "b")) && is_lazy(cJSON_GetObjectItem(root, "d")));
+    CHECK(cJSON_GetArrayItem(x, 0)->valueint == 1);
+    CHECK(!is_lazy(x) && is_lazy(cJSON_GetArrayItem(x, 1)));
+    CHECK(cJSON_GetArraySize(cJSON_GetObjectItem(root, "d")) == 2);
+    CHECK(is_lazy(cJSON_GetArrayItem(cJSON_GetObjectItem(root, "d"), 1)));
+    CHECK(is_lazy(cJSON_GetObjectItem(root, "b")));
+    CHECK(cJSON_Materialize(root, 1) && fully_expanded(root));
+    CHECK(print_unformatted(root) == json);
+    cJSON_Delete(root);
+}
+
+static void test_nested_error() {
+    const std::string json = "{\"ok\":[1,2],\"bad\":{\"x\":1,,\"y\":2},\"list\":[1 2]}";
+    cJSON *root = parse_lazy(json);
+    CHECK(root != NULL);        // 括号成对，解析时发现不了
+    cJSON *bad = cJSON_GetObjectItem(root, "bad");
+    CHECK(is_lazy(bad));
+    CHECK(!cJSON_GetObjectItem(bad, "x"));
+    CHECK(cJSON_GetErrorPtr() == json.data() + json.find(",,") + 1);
+    CHECK(is_lazy(bad) && !bad->child);
+    CHECK(cJSON_GetArraySize(bad) == 0 && is_lazy(bad));
+    cJSON *list = cJSON_GetObjectItem(root, "list");
+    CHECK(!cJSON_GetArrayItem(list, 0) && cJSON_GetArraySize(list) == 0);
+    CHECK(cJSON_GetErrorPtr() == json.data() + json.find("1 2") + 2);
+    CHECK(is_lazy(list));
+    CHECK(cJSON_GetArraySize(cJSON_GetObjectItem(root, "ok")) == 2);    // 其他成员不受影响
+    CHECK(!cJSON_Materialize(root, 1) && is_lazy(bad));
+    CHECK(!cJSON_PrintUnformatted(root) && !cJSON_Duplicate(bad, 1));
+    cJSON_Delete(root);
+
+    CHECK(!parse_lazy("{\"a\":[1,2}") && !parse_lazy("[{\"a\":\"]}"));     // 括号不成对、字符串没有结束
+    CHECK(!parse_lazy("[1,2] x") && !parse_lazy("{\"a\" 1}"));            // 顶层的错误立即发现
+}
+
+/* 含括号、引号和转义的字符串，pad 个填充字符使它们落在 16 字节块的不同位置 */
+static void test_strings_in_blocks() {
+    const char *tricky[] = {"]", "}", "[{", "\\\"]", "\\\\", "\\\\\\\"}", "\\\\\"", "x\\\\", "\\u005D\\/", "]]]]]]]]]]]]]]]]]"};
+    for (const char *s : tricky) {
+        for (size_t pad = 0; pad < 40; pad++) {
+            std::string text = std::string(pad, 'p').append(s);
+            if (text.back() == '"' && text[text.size() - 2] != '\\') text.pop_back();
+            std::string json = std::string("{\"a\":{\"s\":[\"").append(text).append("\",{\"k\":\"").append(text).append(
+                "\"}],\"n\":1},\"b\":[\"").append(text).append("\"]}");
+            cJSON *expected = cJSON_ParseWithLength(json.data(), json.size());
+            if (!expected) continue;    // 拼出的不是合法字符串（如以单个反斜杠结尾）
+            cJSON *root = parse_lazy(json);
+            CHECK(root != NULL);
+            CHECK(cJSON_GetObjectItem(cJSON_GetObjectItem(root, "a"), "n")->valueint == 1);
+            CHECK(cJSON_GetArraySize(cJSON_GetObjectItem(root, "b")) == 1);
+            CHECK(print_unformatted(root) == print_unformatted(expected));
+            cJSON_Delete(root);
+            cJSON_Delete(expected);
+        }
+    }
+}
+
+/* 随机文档：嵌套的数组和对象，字符串里常有括号、引号和反斜杠 */
+static std::string random_value(std::mt19937 &rng, int depth) {
+    static const char *pieces[] = {"[", "]", "{", "}", "\\\"", "\\\\", "\\n", "a", "bc", " ", ",", ":"};
+    std::string out;
+    switch (depth > 5 ? rng() % 3 : rng() % 5) {
+    case 0:
+        return std::to_string((int) (rng() % 2000) - 1000);
+    case 1:
+        return rng() % 2 ? "true" : "null";
+    case 2:
+        out += '"';
+        for (size_t i = 0, n = rng() % 24; i < n; i++) out += pieces[rng() % 12];
+        return out.append("\"");
+    case 3:
+        out += '[';
+        for (size_t i = 0, n = rng() % 6; i < n; i++) out.append(i ? "," : "").append(random_value(rng, depth + 1));
+        return out.append("]");
+    default:
+        out += '{';
+        for (size_t i = 0, n = rng() % 6; i < n; i++)
+            out.append(i ? ",\"k" : "\"k").append(std::to_string(i)).append("\":").append(random_value(rng, depth + 1));
+        return out.append("}");
+    }
+}
+
+static void test_random_materialize() {
+    std::mt19937 rng(23);
+    for (int n = 0; n < 3000; n++) {
+        std::string json = rng() % 2 ? "[" : "{\"r\":[";
+        for (size_t i = 0, m = 1 + rng() % 6; i < m; i++) json.append(i ? "," : "").append(random_value(rng, 0));
+        json.append(json[0] == '[' ? "]" : "]}");
+        std::string expected = roundtrip(json);
+        cJSON *root = parse_lazy(json);
+        CHECK(root != NULL);
+        if (n % 2) CHECK(print_unformatted(root) == expected);     // 直接输出惰性树
+        CHECK(cJSON_Materialize(root, 1) && fully_expanded(root));
+        CHECK(print_unformatted(root) == expected);
+        cJSON_Delete(root);
+    }
+}
+
+static void test_print_duplicate_add() {
+    const std::string json = "{\"a\":{\"x\":[1,{\"y\":\"]\"}]},\"b\":[true,[null]],\"c\":{},\"d\":[[null],{\"e\":[2]}]}";
+    cJSON *root = parse_lazy(json);
+    cJSON *a = cJSON_GetObjectItem(root, "a");
+    cJSON *b = cJSON_GetObjectItem(root, "b");
+    cJSON *d = cJSON_GetObjectItem(root, "d");
+    CHECK(print_unformatted(a) == "{\"x\":[1,{\"y\":\"]\"}]}");
+
+    cJSON *copy = cJSON_Duplicate(b, 1);                 // 副本是普通节点，不依赖输入
+    CHECK(copy && fully_expanded(copy));
+    CHECK(print_unformatted(copy) == "[true,[null]]");
+    cJSON_Delete(copy);
+
+    cJSON *c = cJSON_GetObjectItem(root, "c");
+    CHECK(is_lazy(c));
+    cJSON_AddItemToObject(c, "n", cJSON_CreateNumber(7));
+    CHECK(!is_lazy(c) && cJSON_GetObjectItem(c, "n")->valueint == 7);
+    cJSON *inner = cJSON_GetArrayItem(d, 0);
+    CHECK(is_lazy(inner));
+    cJSON_AddItemToArray(inner, cJSON_CreateString("s"));
+    CHECK(cJSON_GetArraySize(inner) == 2);
+    cJSON *moved = cJSON_DetachItemFromArray(d, 1);      // 把仍是惰性的容器移到别处
+    CHECK(is_lazy(moved));
+    cJSON_AddItemToObject(a, "m", moved);
+    CHECK(print_unformatted(root) ==
+          "{\"a\":{\"x\":[1,{\"y\":\"]\"}],\"m\":{\"e\":[2]}},\"b\":[true,[null]],\"c\":{\"n\":7},\"d\":[[null,\"s\"]]}");
+    copy = cJSON_Duplicate(root, 1);
+    CHECK(fully_expanded(copy) && print_unformatted(copy) == print_unformatted(root));
+    cJSON_Delete(copy);
+    cJSON_Delete(root);
+}
+
+int main() {
+    test_path_only();
+    test_nested_error();
+    test_strings_in_blocks();
+    test_random_materialize();
+    test_print_duplicate_add();
+    return test_report("lazy");
+}
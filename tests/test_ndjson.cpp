@@ -0,0 +1,136 @@
+/*
+ * NDJSON 并行解析：输入超过几个 CJSON_NDJSON_BATCH（1 MiB）批，有记录跨过、也有记录恰好开始于批的边界。
+ * 有序和无序模式、不同线程数下的记录数、偏移和内容都与逐行解析相同，有序模式下顺序也相同；
+ * 空行、\r\n 行尾和没有换行的最后一行都要处理。后面的批出错时有序模式正好交付之前的记录并报告出错位置，
+ * 回调返回假时得到 cJSON_ParseStopped。
+ */
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test.hpp"
+
+static const size_t batch = 1 << 20;   // 与 cJSON.cpp 中的 CJSON_NDJSON_BATCH 相同
+
+typedef std::vector<std::pair<size_t, std::string>> record_list;     // 偏移和紧凑输出
+
+struct collector {
+    std::mutex lock;
+    record_list records;
+    size_t stop_after = (size_t) -1;    // 交付这么多条之后回调返回假
+};
+
+static cJSON_bool collect(cJSON *record, size_t offset, void *ctx) {
+    collector *c = (collector *) ctx;
+    std::lock_guard<std::mutex> guard(c->lock);
+    c->records.emplace_back(offset, print_unformatted(record));
+    return c->records.size() < c->stop_after;
+}
+
+static std::string random_record(std::mt19937 &rng, size_t id) {
+    std::string line = "{\"id\":";
+    line.append(std::to_string(id)).append(",\"name\":\"");
+    line.append(rng() % 200, (char) ('a' + rng() % 26)).append("\",\"list\":[");
+    for (size_t i = 0, n = rng() % 30; i < n; i++) line.append(i ? "," : "").append(std::to_string(rng() % 100000));
+    return line.append(rng() % 4 ? "]}" : "], \"nested\": {\"x\": [true, null]} }");
+}
+
+/* 大约 bytes 字节的输入和逐行解析得到的记录；空行、\r\n 行尾随机出现，最后一行没有换行 */
+static std::string make_input(size_t bytes, record_list *expected) {
+    std::mt19937 rng(17);
+    std::string text;
+    for (size_t id = 0; text.size() < bytes; id++) {
+        if (rng() % 20 == 0) text.append(rng() % 2 ? "\n" : " \r\n");
+        std::string line = random_record(rng, id);
+        size_t next = text.size() / batch * batch + batch;
+        if (next - text.size() < 300 && next - text.size() > 1) {      // 让下一条记录恰好从批的边界开始
+            text.append(next - text.size() - 1, ' ').push_back('\n');
+        }
+        expected->emplace_back(text.size(), roundtrip(line));
+        text.append(line).append(rng() % 3 ? "\n" : "\r\n");
+    }
+    while (text.back() == '\n' || text.back() == '\r') text.pop_back();
+    return text;
+}
+
+static void test_records(const std::string &text, const record_list &expected) {
+    for (cJSON_bool ordered : {1, 0}) {
+        for (int threads : {1, 2, 4, 0}) {
+            collector c;
+            CHECK(cJSON_ParseNdjson(text.data(), text.size(), threads, ordered, collect, &c) == cJSON_ParseDone);
+            CHECK(cJSON_GetErrorPtr() == NULL);
+            if (!ordered) std::sort(c.records.begin(), c.records.end());
+            CHECK(c.records.size() == expected.size());
+            CHECK(c.records == expected);
+        }
+    }
+}
+
+/* 在第三批中间把一条记录换成错误的记录 */
+static void test_error(const std::string &text, const record_list &expected) {
+    size_t index = 0;
+    while (expected[index].first < 2 * batch + batch / 2) index++;
+    size_t at = expected[index].first;
+    std::string bad = text;
+    bad.replace(at, 7, "{\"id\":,");      // 原来是 {"id":N 的开头
+    size_t line_end = bad.find('\n', at);
+    std::string line = bad.substr(at, line_end - at);
+    CHECK(!cJSON_ParseWithLength(line.data(), line.size()));
+    size_t error_offset = at + (size_t) (cJSON_GetErrorPtr() - line.data());
+
+    for (int threads : {1, 4}) {
+        collector c;
+        CHECK(cJSON_ParseNdjson(bad.data(), bad.size(), threads, 1, collect, &c) == cJSON_ParseError);
+        CHECK(cJSON_GetErrorPtr() == bad.data() + error_offset);
+        CHECK(c.records == record_list(expected.begin(), expected.begin() + (long) index));
+
+        collector u;
+        CHECK(cJSON_ParseNdjson(bad.data(), bad.size(), threads, 0, collect, &u) == cJSON_ParseError);
+        CHECK(cJSON_GetErrorPtr() == bad.data() + error_offset);
+    }
+}
+
+static void test_stop(const std::string &text, const record_list &expected) {
+    for (size_t stop_after : {(size_t) 1, expected.size() / 2, expected.size() - 1}) {
+        for (int threads : {1, 4}) {
+            collector c;
+            c.stop_after = stop_after;
+            CHECK(cJSON_ParseNdjson(text.data(), text.size(), threads, 1, collect, &c) == cJSON_ParseStopped);
+            CHECK(cJSON_GetErrorPtr() == NULL);
+            CHECK(c.records == record_list(expected.begin(), expected.begin() + (long) stop_after));
+
+            collector u;
+            u.stop_after = stop_after;
+            CHECK(cJSON_ParseNdjson(text.data(), text.size(), threads, 0, collect, &u) == cJSON_ParseStopped);
+            CHECK(u.records.size() >= stop_after);
+        }
+    }
+}
+
+static void test_small() {
+    collector c;
+    const std::string text = "\n\r\n[1]\r\n  \n{\"a\":2}\n\"s\"";
+    CHECK(cJSON_ParseNdjson(text.data(), text.size(), 0, 1, collect, &c) == cJSON_ParseDone);
+    CHECK(c.records == record_list({{3, "[1]"}, {11, "{\"a\":2}"}, {19, "\"s\""}}));
+    c.records.clear();
+    CHECK(cJSON_ParseNdjson("", 0, 0, 1, collect, &c) == cJSON_ParseDone && c.records.empty());
+    CHECK(cJSON_ParseNdjson("[1] [2]\n", 8, 0, 1, collect, &c) == cJSON_ParseError);    // 一行只能有一个值
+    CHECK(cJSON_ParseNdjson(NULL, 0, 0, 1, collect, &c) == cJSON_ParseError);
+}
+
+int main() {
+    record_list expected;
+    const std::string text = make_input(3 * batch + batch / 3, &expected);
+    CHECK(std::any_of(expected.begin(), expected.end(), [](const std::pair<size_t, std::string> &r) {
+        return r.first && r.first % batch == 0;
+    }));
+    test_small();
+    test_records(text, expected);
+    test_error(text, expected);
+    test_stop(text, expected);
+    return test_report("ndjson");
+}
@@ -0,0 +1,87 @@
+/*
+ * 数字解析：与 strtod 和 std::from_chars 逐位比较（两者都是正确舍入的），覆盖整数、Clinger、Eisel-Lemire 和兜底路径。
+ */
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+static bool same_bits(double a, double b) {
+    return !memcmp(&a, &b, sizeof(double));
+}
+
+/* 解析 lexeme，结果须与 strtod 和 from_chars 逐位相同 */
+static void check_number(const char *lexeme) {
+    size_t length = strlen(lexeme);
+    cJSON *item = cJSON_ParseWithLength(lexeme, length);
+    double expected = strtod(lexeme, NULL), other = 0;
+    if (std::from_chars(lexeme, lexeme + length, other).ec == std::errc()) CHECK(same_bits(expected, other));  // 上溢和下溢时 from_chars 不写结果
+    CHECK(item && (item->type & cJSON_Number));
+    if (item && !same_bits(cJSON_GetNumberValue(item), expected)) {
+        fprintf(stderr, "  %s: got %.17g, expected %.17g\n", lexeme, cJSON_GetNumberValue(item), expected);
+        CHECK(false);
+    }
+    cJSON_Delete(item);
+}
+
+static void test_edge_cases() {
+    static const char *cases[] = {
+            "0", "-0", "1", "-1", "0.1", "0.3", "1.5", "-0.0e5", "1E+2", "123.456e-5",
+            "9007199254740991", "9007199254740992", "9007199254740993", "-9007199254740993",  // 2^53 ± 1
+            "9007199254740995", "18014398509481985",
+            "9223372036854775807", "-9223372036854775808", "9223372036854775808", "18446744073709551616",
+            "1e22", "1e23", "9007199254740991e22", "0.1e-22", "1e37", "3e37",
+            "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308",
+            "2.2250738585072014e-308", "2.2250738585072011e-308", "4.9e-324", "2.4703282292062327e-324",
+            "7.1e-323", "1e-400", "-1e-400", "1e400", "-1e400", "1e99999999",
+            "123456789012345678901234567890", "0.000001", "12345678901234567e-10",
+            "1.00000000000000011102230246251565404236316680908203125",   // 恰好在两个 double 正中间
+            "1.00000000000000011102230246251565404236316680908203126",
+            "0.30000000000000004", "2.5e15", "4503599627370496.5", "4503599627370497.5",
+    };
+    for (const char *lexeme : cases) check_number(lexeme);
+
+    cJSON *item = cJSON_Parse("-0");
+    CHECK(item && std::signbit(item->valuedouble));
+    cJSON_Delete(item);
+    item = cJSON_Parse("[3e10,-3e10,2147483647,-2147483648,7.9]");
+    CHECK(cJSON_GetArrayItem(item, 0)->valueint == INT_MAX);     // valueint 取边界值
+    CHECK(cJSON_GetArrayItem(item, 1)->valueint == INT_MIN);
+    CHECK(cJSON_GetArrayItem(item, 2)->valueint == INT_MAX);
+    CHECK(cJSON_GetArrayItem(item, 3)->valueint == INT_MIN);
+    CHECK(cJSON_GetArrayItem(item, 4)->valueint == 7);
+    cJSON_Delete(item);
+}
+
+static void test_random() {
+    std::mt19937_64 rng(42);
+    char buf[128];
+    for (int i = 0; i < 100000; i++) {
+        unsigned long long bits = rng();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (std::isfinite(d)) {
+            snprintf(buf, sizeof(buf), "%.17g", d);
+            check_number(buf);
+            snprintf(buf, sizeof(buf), "%.*g", (int) (rng() % 17) + 1, d);
+            check_number(buf);
+        }
+        snprintf(buf, sizeof(buf), "%llu.%llu", (unsigned long long) (rng() % 1000000), (unsigned long long) (rng() % 100000));
+        check_number(buf);
+        snprintf(buf, sizeof(buf), "%llue%d", (unsigned long long) (rng() % 10000000000000000000ULL), (int) (rng() % 700) - 350);
+        check_number(buf);
+        snprintf(buf, sizeof(buf), "-%llu%llu", (unsigned long long) rng(), (unsigned long long) (rng() % 1000));  // 超过 19 位
+        check_number(buf);
+        if (test_failures > 20) break;
+    }
+}
+
+int main() {
+    test_edge_cases();
+    test_random();
+    return test_report("numbers");
+}
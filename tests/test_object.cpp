@@ -0,0 +1,138 @@
+/*
+ * 对象成员查找与哈希索引：随机的添加、分离、替换和删除与 std::vector 模型对照，
+ * 对象分别处于没有索引、自动建立索引和显式建立索引的状态；每步之后按键查找的结果都要与沿 child/next 遍历一致。
+ */
+#include <strings.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test.hpp"
+
+typedef std::vector<std::pair<std::string, int>> object_model;
+
+/* 沿链表找第一个键相同（不区分大小写）的成员，作为查找的参照 */
+static cJSON *walk_find(const cJSON *object, const std::string &key, bool case_sensitive) {
+    for (cJSON *c = object->child; c; c = c->next) {
+        std::string name = c->string;
+        if (case_sensitive ? name == key : strcasecmp(name.c_str(), key.c_str()) == 0) return c;
+    }
+    return NULL;
+}
+
+static void check_object(const cJSON *object, const object_model &model, const std::vector<std::string> &keys) {
+    size_t n = 0;
+    const cJSON *last = NULL;
+    for (cJSON *c = object->child; c; c = c->next, n++) {
+        if (n < model.size()) CHECK(c->string == model[n].first && c->valueint == model[n].second);
+        last = c;
+    }
+    CHECK(n == model.size());
+    CHECK((size_t) cJSON_GetArraySize(object) == model.size());
+    if (object->child) CHECK(object->child->prev == last);
+    for (const std::string &key : keys) {
+        cJSON_Key prepared = cJSON_PrepareKey(key.c_str());
+        CHECK(cJSON_GetObjectItem(object, key.c_str()) == walk_find(object, key, false));
+        CHECK(cJSON_GetObjectItemCaseSensitive(object, key.c_str()) == walk_find(object, key, true));
+        CHECK(cJSON_GetObjectItemByKey(object, &prepared) == walk_find(object, key, true));
+    }
+}
+
+static void test_random(size_t members, int mode) {
+    std::mt19937 rng((unsigned) members * 3 + mode);
+    std::vector<std::string> keys;
+    object_model model;
+    cJSON *object = cJSON_CreateObject();
+    for (size_t i = 0; i < members * 2; i++) {
+        keys.push_back(std::string("key").append(std::to_string(i)));
+        if (i % 5 == 0) keys.push_back(std::string("KEY").append(std::to_string(i)));     // 只有大小写不同的键
+    }
+
+    for (int step = 0; step < 1500; step++) {
+        const std::string &key = keys[rng() % keys.size()];
+        int value = (int) (rng() % 1000000);
+        size_t pos;
+        switch (rng() % 8) {
+        case 0:
+        case 1:
+        case 2:
+            if (model.size() < members) {
+                cJSON_AddItemToObject(object, key.c_str(), cJSON_CreateNumber(value));
+                model.emplace_back(key, value);
+            }
+            break;
+        case 3:     // 分离第一个同名成员
+            for (pos = 0; pos < model.size() && strcasecmp(model[pos].first.c_str(), key.c_str()); pos++) {}
+            {
+                cJSON *detached = cJSON_DetachItemFromObject(object, key.c_str());
+                CHECK((detached != NULL) == (pos < model.size()));
+                if (detached && pos < model.size()) {
+                    CHECK(detached->string == model[pos].first && !detached->next && !detached->prev);
+                    model.erase(model.begin() + (long) pos);
+                }
+                cJSON_Delete(detached);
+            }
+            break;
+        case 4:     // 替换第一个同名成员，新成员用调用者给的键
+            for (pos = 0; pos < model.size() && strcasecmp(model[pos].first.c_str(), key.c_str()); pos++) {}
+            {
+                cJSON *replacement = cJSON_CreateNumber(value);
+                cJSON_ReplaceItemInObject(object, key.c_str(), replacement);
+                if (pos < model.size()) model[pos] = {key, value};
+                else cJSON_Delete(replacement);     // 没有同名成员时不接管新成员
+            }
+            break;
+        case 5:
+            if (!model.empty()) {   // 用成员自己的键替换它的副本
+                pos = rng() % model.size();
+                cJSON *copy = cJSON_Duplicate(walk_find(object, model[pos].first, true), 1);
+                size_t first = 0;
+                for (; strcasecmp(model[first].first.c_str(), model[pos].first.c_str()); first++) {}
+                cJSON_SetIntValue(copy, value);
+                cJSON_ReplaceItemInObject(object, copy->string, copy);
+                model[first] = {model[pos].first, value};
+            }
+            break;
+        case 6:
+            if (mode == 2) cJSON_BuildObjectIndex(object);
+            else if (mode == 0) cJSON_DropObjectIndex(object);
+            break;
+        default:
+            if (rng() % 50 == 0) {
+                cJSON_Delete(object);
+                object = cJSON_CreateObject();
+                model.clear();
+            }
+            break;
+        }
+        if (step % 7 == 0 || model.size() < 40) check_object(object, model, keys);
+    }
+    check_object(object, model, keys);
+    cJSON_Delete(object);
+}
+
+/* 以新成员自己的键替换：键须先复制再释放 */
+static void test_replace_with_own_key() {
+    for (int members : {2, 100}) {
+        cJSON *object = cJSON_CreateObject();
+        for (int i = 0; i < members; i++) cJSON_AddItemToObject(object, std::string("k").append(std::to_string(i)).c_str(), cJSON_CreateNumber(i));
+        cJSON *replacement = cJSON_Duplicate(cJSON_GetObjectItem(object, "k1"), 1);
+        cJSON_SetIntValue(replacement, 42);
+        cJSON_ReplaceItemInObject(object, replacement->string, replacement);
+        CHECK(cJSON_GetObjectItem(object, "k1") == replacement);
+        CHECK(std::string(replacement->string) == "k1" && replacement->valueint == 42);
+        CHECK(cJSON_GetArraySize(object) == members);
+        cJSON_Delete(object);
+    }
+}
+
+int main() {
+    test_replace_with_own_key();
+    for (size_t members : {8, 40, 300}) {
+        for (int mode = 0; mode < 3; mode++) test_random(members, mode);
+    }
+    return test_report("object");
+}
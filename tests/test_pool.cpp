@@ -0,0 +1,119 @@
+/*
+ * 节点池：调用者替换或就地截短字符串之后，节点池回收的块不能分给需要更大容量的请求。
+ * 通过 cJSON_InitHooks 记录每个块的实际大小，检查之后解析得到的每个字符串都放得下。
+ */
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+static std::map<void *, size_t> live;     // 由分配函数分配、尚未释放的块及其大小
+
+static void *tracked_malloc(size_t size) {
+    void *ptr = malloc(size ? size : 1);
+    if (ptr) live[ptr] = size;
+    return ptr;
+}
+
+static void tracked_free(void *ptr) {
+    if (!ptr) return;
+    CHECK(live.erase(ptr) == 1);
+    free(ptr);
+}
+
+/* 调用者自己分配的、刚好放得下 text 的缓冲区 */
+static char *exact_copy(const std::string &text) {
+    char *copy = (char *) tracked_malloc(text.size() + 1);
+    memcpy(copy, text.c_str(), text.size() + 1);
+    return copy;
+}
+
+/* 紧凑输出，缓冲区来自分配函数，须由 tracked_free 释放 */
+static std::string printed(cJSON *item) {
+    char *text = cJSON_PrintUnformatted(item);
+    std::string out = text ? text : "<print failed>";
+    tracked_free(text);
+    return out;
+}
+
+/* 树中每个键和字符串值所在的块都要放得下它自己 */
+static void check_capacity(const cJSON *item) {
+    for (; item; item = item->next) {
+        if (item->string) CHECK(live.count(item->string) && live[item->string] >= strlen(item->string) + 1);
+        if (item->valuestring) CHECK(live.count(item->valuestring) && live[item->valuestring] >= strlen(item->valuestring) + 1);
+        check_capacity(item->child);
+    }
+}
+
+/* 含 0 到 max 各种长度的键和字符串值的对象 */
+static std::string sized_document(size_t max, char fill) {
+    std::string json = "{";
+    for (size_t n = 0; n <= max; n++) {
+        if (n) json += ',';
+        json.append("\"").append(std::to_string(n)).append(n % 7, fill).append("\":\"").append(n, fill).append("\"");
+    }
+    return json + "}";
+}
+
+static void test_replaced_strings() {
+    std::mt19937 rng(19);
+    cJSON_NodePoolStats stats;
+    for (int round = 0; round < 20; round++) {
+        cJSON *root = cJSON_Parse(sized_document(300, 'a').c_str());
+        CHECK(root != NULL);
+        for (cJSON *item = root->child; item; item = item->next) {
+            switch (rng() % 4) {
+            case 0: // 换成更短的、调用者分配的缓冲区
+                tracked_free(item->valuestring);
+                item->valuestring = exact_copy(std::string(rng() % 40, 'b'));
+                break;
+            case 1: // 就地截短
+                item->valuestring[rng() % (strlen(item->valuestring) + 1)] = 0;
+                break;
+            case 2: // 键也换掉
+                tracked_free(item->string);
+                item->string = exact_copy(std::to_string(rng() % 1000));
+                break;
+            default:
+                break;
+            }
+        }
+        cJSON_Delete(root);
+
+        root = cJSON_Parse(sized_document(300, 'c').c_str());
+        CHECK(root != NULL);
+        check_capacity(root);
+        cJSON *copy = cJSON_Duplicate(root, 1);
+        check_capacity(copy);
+        CHECK(printed(copy) == printed(root));
+        cJSON_Delete(copy);
+        cJSON_Delete(root);
+    }
+    cJSON_GetNodePoolStats(&stats);
+    CHECK(stats.hits > 0);
+}
+
+static void test_trim() {
+    cJSON_NodePoolStats stats;
+    cJSON_Delete(cJSON_Parse(sized_document(100, 'd').c_str()));
+    cJSON_GetNodePoolStats(&stats);
+    CHECK(stats.cached_bytes > 0);
+    cJSON_TrimNodePool(1000);
+    cJSON_GetNodePoolStats(&stats);
+    CHECK(stats.cached_bytes <= 1000);
+    cJSON_DisableNodePool();
+    cJSON_GetNodePoolStats(&stats);
+    CHECK(stats.cached_bytes == 0);
+}
+
+int main() {
+    cJSON_Hooks hooks = {tracked_malloc, tracked_free};
+    cJSON_InitHooks(&hooks);
+    cJSON_EnableNodePool(1 << 20);
+    test_replaced_strings();
+    test_trim();
+    CHECK(live.empty());
+    return test_report("pool");
+}
@@ -0,0 +1,123 @@
+/*
+ * 输出：数字的最短往返格式、各输出接口结果一致、格式化输出的排版。
+ */
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+static std::string print_number(double d) {
+    cJSON *item = cJSON_CreateNumber(d);
+    std::string out = print_unformatted(item);
+    cJSON_Delete(item);
+    return out;
+}
+
+/* 有效数字的位数：去掉符号、小数点、指数和首尾的 0 */
+static int significant_digits(const std::string &text) {
+    std::string digits;
+    for (char c : text) {
+        if (c == 'e' || c == 'E') break;
+        if (c >= '0' && c <= '9') digits += c;
+    }
+    size_t first = digits.find_first_not_of('0'), last = digits.find_last_not_of('0');
+    return first == std::string::npos ? 0 : (int) (last - first + 1);
+}
+
+/* 能往返的最短 %.Ng 的位数 */
+static int shortest_digits(double d) {
+    char buf[64];
+    for (int precision = 1; precision < 17; precision++) {
+        snprintf(buf, sizeof(buf), "%.*g", precision, d);
+        if (strtod(buf, NULL) == d) return precision;
+    }
+    return 17;
+}
+
+static void test_number_formats() {
+    static const struct {
+        double value;
+        const char *expected;
+    } cases[] = {
+            {0, "0"}, {-0.0, "-0"}, {1, "1"}, {-1, "-1"}, {0.1, "0.1"}, {1.5, "1.5"}, {100, "100"},
+            {1e16, "10000000000000000"}, {1e17, "100000000000000000"}, {1e21, "1e21"}, {1.5e300, "1.5e300"},
+            {5e-324, "5e-324"}, {1e-7, "1e-7"}, {0.000001, "0.000001"}, {123456.789, "123456.789"},
+            {-2.5e-10, "-2.5e-10"}, {2147483648.0, "2147483648"}, {9007199254740992.0, "9007199254740992"},
+            {1.7976931348623157e308, "1.7976931348623157e308"}, {NAN, "null"}, {INFINITY, "null"}, {-INFINITY, "null"},
+    };
+    for (const auto &c : cases) CHECK(print_number(c.value) == c.expected);
+}
+
+/*
+ * 随机位模式的 double 输出后重新解析须逐位相同。
+ * Grisu2 在极少数情况下比最短表示多一两位（仍能往返），这里只限制这种情况的比例。
+ */
+static void test_number_roundtrip() {
+    std::mt19937_64 rng(5);
+    int count = 0, longer = 0;
+    for (int i = 0; i < 50000; i++) {
+        unsigned long long bits = rng();
+        double d, back;
+        memcpy(&d, &bits, sizeof(d));
+        if (!std::isfinite(d)) continue;
+        std::string text = print_number(d);
+        back = strtod(text.c_str(), NULL);
+        CHECK(!memcmp(&d, &back, sizeof(d)));
+        CHECK(significant_digits(text) <= 17);
+        longer += significant_digits(text) > shortest_digits(d);
+        count++;
+        if (test_failures > 20) break;
+    }
+    CHECK(longer * 500 < count);    // 不超过 0.2%
+}
+
+static cJSON_bool append(const char *data, size_t length, void *ctx) {
+    ((std::string *) ctx)->append(data, length);
+    return 1;
+}
+
+/* 格式化输出的排版，以及各输出接口对同一棵树的结果相同 */
+static void test_print_paths() {
+    const char *json = "{\"a\":[1,2.5,{\"b\":null}],\"c\":\"x\\ny\",\"d\":{},\"e\":[],\"f\":true}";
+    const char *pretty = "{\n\t\"a\": [1, 2.5, {\n\t\t\t\"b\": null\n\t\t}],\n\t\"c\": \"x\\ny\",\n\t\"d\": {\n},\n"
+                         "\t\"e\": [],\n\t\"f\": true\n}";     // 与原来的排版相同，包括空对象的写法
+    cJSON *root = cJSON_Parse(json);
+    char *text = cJSON_Print(root);
+    CHECK(!strcmp(text, pretty));
+    free(text);
+
+    for (int fmt = 0; fmt < 2; fmt++) {
+        std::string expected, written;
+        char buffer[256];
+        size_t required = 0;
+        text = fmt ? cJSON_Print(root) : cJSON_PrintUnformatted(root);
+        expected = text;
+        free(text);
+        for (int prebuffer = 1; prebuffer < 80; prebuffer += 7) {
+            text = cJSON_PrintBuffered(root, prebuffer, fmt);
+            CHECK(expected == text);
+            free(text);
+        }
+        CHECK(cJSON_PrintToWriter(root, fmt, append, &written) && written == expected);
+        CHECK(cJSON_PrintPreallocated(root, buffer, sizeof(buffer), fmt, &required) && expected == buffer);
+        CHECK(required == expected.size() + 1);
+        CHECK(cJSON_PrintPreallocated(root, buffer, required, fmt, NULL));
+        CHECK(!cJSON_PrintPreallocated(root, buffer, required - 1, fmt, &required) && required == expected.size() + 1);
+        required = 0;
+        CHECK(!cJSON_PrintPreallocated(root, NULL, 0, fmt, &required) && required == expected.size() + 1);    // 只查询大小
+        required = 0;
+        CHECK(!cJSON_PrintPreallocated(root, buffer, 0, fmt, &required) && required == expected.size() + 1);
+        CHECK(!cJSON_PrintPreallocated(NULL, buffer, sizeof(buffer), fmt, &required) && required == 0);
+    }
+    CHECK(print_unformatted(root) == json);
+    cJSON_Delete(root);
+}
+
+int main() {
+    test_number_formats();
+    test_number_roundtrip();
+    test_print_paths();
+    return test_report("print");
+}
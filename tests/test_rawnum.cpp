@@ -0,0 +1,111 @@
+/*
+ * 保留原文的数字（cJSON_KeepNumberText）：输出与输入逐字相同，cJSON_GetNumberValue 的结果与 strtod 逐位相同，
+ * 修改数值后原文被丢弃；宽松接受的写法不保留原文，结果与不带选项的解析相同。
+ */
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+static cJSON *parse_raw(const std::string &json) {
+    return cJSON_ParseWithFlags(json.data(), json.size(), cJSON_KeepNumberText);
+}
+
+static bool same_double(double a, double b) {
+    return !memcmp(&a, &b, sizeof(double));
+}
+
+/* 单个数字：原文原样输出，解码结果与 strtod 相同 */
+static void check_number(const std::string &text) {
+    cJSON *root = parse_raw(text);
+    CHECK(root && (root->type & cJSON_NumberIsRaw) && !strcmp(root->valuestring, text.c_str()));
+    CHECK(print_unformatted(root) == text);
+    CHECK(same_double(cJSON_GetNumberValue(root), strtod(text.c_str(), NULL)));
+    CHECK(print_unformatted(root) == text);     // 解码后仍输出原文
+    cJSON_Delete(root);
+}
+
+static void test_verbatim() {
+    for (const char *text : {"0", "-0", "0.0", "1E+2", "1e-0", "0.1e-5", "123456789012345678901234567890",
+                             "9007199254740993", "1.000000000000000000001", "1e400", "-1e400", "4.9e-325",
+                             "2.2250738585072011e-308", "-9223372036854775809", "100000000000000000000000e-23"})
+        check_number(text);
+
+    const std::string json = "{\"id\":18446744073709551615,\"price\":19.90,\"list\":[1.0,2.50,-0.0,3E2]}";
+    cJSON *root = parse_raw(json);
+    CHECK(print_unformatted(root) == json);
+    cJSON *copy = cJSON_Duplicate(root, 1);
+    CHECK(print_unformatted(copy) == json);
+    cJSON_Delete(copy);
+    char *text = cJSON_Print(root);
+    CHECK(text && strstr(text, "18446744073709551615") && strstr(text, "19.90") && strstr(text, "3E2"));
+    free(text);
+    cJSON_Delete(root);
+}
+
+static void test_decode() {
+    cJSON *root = parse_raw("[9007199254740993,-9223372036854775808,3000000000,2.5,1e400]");
+    cJSON *item = root->child;
+    CHECK(cJSON_GetInt64(item) == 9007199254740993LL);      // 不经过 double
+    CHECK(cJSON_GetNumberValue(item) == 9007199254740992.0);
+    item = item->next;
+    CHECK(cJSON_GetInt64(item) == LLONG_MIN);
+    item = item->next;
+    CHECK(cJSON_GetNumberValue(item) == 3e9 && item->valueint == INT_MAX);
+    item = item->next;
+    CHECK(cJSON_GetNumberValue(item) == 2.5 && item->valueint == 2);
+    item = item->next;
+    CHECK(std::isinf(cJSON_GetNumberValue(item)));
+    CHECK(print_unformatted(root) == "[9007199254740993,-9223372036854775808,3000000000,2.5,1e400]");
+    cJSON_Delete(root);
+}
+
+static void test_set_drops_text() {
+    cJSON *root = parse_raw("[1.50,12345678901234567890]");
+    cJSON_SetNumberValue(root->child, 2);
+    CHECK(!(root->child->type & cJSON_NumberIsRaw) && !root->child->valuestring);
+    cJSON_SetInt64Value(root->child->next, -5);
+    CHECK(!(root->child->next->type & cJSON_NumberIsRaw));
+    CHECK(print_unformatted(root) == "[2,-5]");
+    cJSON_Delete(root);
+}
+
+static void test_lenient() {
+    // 宽松接受的写法不保留原文，接受与否和结果都与不带选项的解析相同
+    for (const char *json : {"[-]", "[1.]", "[01]", "[.5]", "[1e]", "[+1]", "[1.e5]", "[-.5]", "[00.1]"}) {
+        std::string expected = roundtrip(json);
+        cJSON *root = parse_raw(json);
+        CHECK(print_unformatted(root) == expected);
+        if (root && root->child) CHECK(!(root->child->type & cJSON_NumberIsRaw));
+        cJSON_Delete(root);
+    }
+    CHECK(!parse_raw("[1x]") && !parse_raw("[--1]"));
+}
+
+static void test_random() {
+    std::mt19937 rng(24);
+    for (int n = 0; n < 20000; n++) {
+        std::string text = rng() % 2 ? "-" : "";
+        size_t digits = 1 + rng() % 25;
+        text += (char) (digits == 1 ? '0' + rng() % 10 : '1' + rng() % 9);
+        for (size_t i = 1; i < digits; i++) text += (char) ('0' + rng() % 10);
+        if (rng() % 2) {
+            text += '.';
+            for (size_t i = 0, m = 1 + rng() % 20; i < m; i++) text += (char) ('0' + rng() % 10);
+        }
+        if (rng() % 2) text.append(rng() % 2 ? "e" : "E").append(rng() % 3 ? "-" : "+").append(std::to_string(rng() % 330));
+        check_number(text);
+    }
+}
+
+int main() {
+    test_verbatim();
+    test_decode();
+    test_set_drops_text();
+    test_lenient();
+    test_random();
+    return test_report("rawnum");
+}
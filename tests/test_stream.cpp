@@ -0,0 +1,121 @@
+/*
+ * 流式解析：同一份输入按各种边界切块送入（包括字符串、\u 转义和数字的中间），
+ * 建树结果须与一次性解析相同，SAX 事件序列须与 cJSON_ParseSax 相同。
+ */
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+
+/* 把事件记成文本，便于比较 */
+static cJSON_bool log_event(void *ctx, const std::string &event) {
+    ((std::string *) ctx)->append(event).push_back('|');
+    return 1;
+}
+
+static const cJSON_SaxHandler logger = {
+        [](void *ctx) { return log_event(ctx, "null"); },
+        [](cJSON_bool value, void *ctx) { return log_event(ctx, value ? "true" : "false"); },
+        [](double value, void *ctx) {
+            char buf[40];
+            snprintf(buf, sizeof(buf), "%.17g", value);
+            return log_event(ctx, buf);
+        },
+        [](const char *str, size_t length, void *ctx) { return log_event(ctx, "s:" + std::string(str, length)); },
+        [](void *ctx) { return log_event(ctx, "{"); },
+        [](const char *str, size_t length, void *ctx) { return log_event(ctx, "k:" + std::string(str, length)); },
+        [](void *ctx) { return log_event(ctx, "}"); },
+        [](void *ctx) { return log_event(ctx, "["); },
+        [](void *ctx) { return log_event(ctx, "]"); },
+};
+
+/* 按 cuts 切块送入，每块复制到刚好大小的堆内存，送入后立即释放 */
+static int feed(cJSON_Stream *stream, const std::string &text, const std::vector<size_t> &cuts) {
+    size_t from = 0;
+    int status;
+    for (size_t cut : cuts) {
+        char *chunk = (char *) malloc(cut - from + 1);
+        memcpy(chunk, text.data() + from, cut - from);
+        status = cJSON_StreamFeed(stream, chunk, cut - from);
+        free(chunk);
+        from = cut;
+        if (status != cJSON_ParseNeedMore && status != cJSON_ParseDone) return status;
+    }
+    return cJSON_StreamFinish(stream);
+}
+
+static void check_split(const std::string &text, const std::vector<size_t> &cuts) {
+    cJSON *expected = cJSON_ParseWithLengthOpts(text.data(), text.size(), NULL, 1), *tree;
+    cJSON_Stream *stream = cJSON_CreateStream(NULL, NULL);
+    int status = feed(stream, text, cuts);
+    std::string direct, streamed;
+
+    tree = cJSON_StreamDetachTree(stream);
+    CHECK((status == cJSON_ParseDone) == (expected != NULL));
+    CHECK(print_unformatted(tree) == print_unformatted(expected));
+    cJSON_Delete(tree);
+    cJSON_DeleteStream(stream);
+    cJSON_Delete(expected);
+
+    status = cJSON_ParseSax(text.data(), text.size(), &logger, &direct);
+    stream = cJSON_CreateStream(&logger, &streamed);
+    CHECK(feed(stream, text, cuts) == status);
+    CHECK(streamed == direct);
+    cJSON_DeleteStream(stream);
+}
+
+static const char *documents[] = {
+        "{\"a\":[1,2.5,-3e2,{\"b\":null}],\"c\":\"x\\ny\",\"d\":{},\"e\":[],\"f\":true,\"g\":false}",
+        "\"\\u00e9\\ud83d\\ude00x\\n\"", "{\"a\\tb\":\"\\\\\\\"\",\"c\":[\"\",\"\\u0041\",{},[]]}", "  [1,\"x\"]  ",
+        "-0.5e-3", "123", "true", "false", "null", "[1.5e+10,-0,true,null,false,\"\\\\\\\\\"]", "{\"\":{\"\":[]}}",
+        "[\"a string long enough to cross one or two SIMD blocks of input\", 12345678901234567890]",
+        "[tru]", "{\"a\" 1}", "{\"a\":1,}", "[1,]", "[1 2]", "{,}", "{1:2}", "[1]]", " ", "[truefalse]", "nul",
+        "\"abc", "[1] x",
+};
+
+static void test_splits() {
+    std::mt19937 rng(16);
+    for (const char *document : documents) {
+        std::string text = document;
+        std::vector<size_t> bytewise;
+        for (size_t at = 0; at <= text.size(); at++) check_split(text, {at, text.size()});   // 两块
+        for (size_t at = 1; at <= text.size(); at++) bytewise.push_back(at);
+        check_split(text, bytewise);    // 逐字节
+        for (int k = 0; k < 20; k++) {
+            std::vector<size_t> cuts;
+            for (size_t at = 0; at < text.size();) {
+                at = std::min(text.size(), at + 1 + rng() % 13);
+                cuts.push_back(at);
+            }
+            check_split(text, cuts);
+        }
+    }
+}
+
+static void test_after_done() {
+    cJSON_Stream *stream = cJSON_CreateStream(NULL, NULL);
+    CHECK(cJSON_StreamFeed(stream, "[1] ", 4) == cJSON_ParseDone);
+    CHECK(cJSON_StreamFeed(stream, "  ", 2) == cJSON_ParseDone);       // 之后只允许空白
+    CHECK(cJSON_StreamFeed(stream, " x", 2) == cJSON_ParseError);
+    CHECK(!cJSON_StreamDetachTree(stream));
+    CHECK(cJSON_StreamFeed(stream, "", 0) == cJSON_ParseError);       // 结束后返回相同的结果
+    cJSON_DeleteStream(stream);
+
+    stream = cJSON_CreateStream(NULL, NULL);
+    CHECK(cJSON_StreamFeed(stream, "12", 2) == cJSON_ParseNeedMore);
+    CHECK(cJSON_StreamFeed(stream, "3", 1) == cJSON_ParseNeedMore);   // 根值是数字时要等到输入结束
+    CHECK(cJSON_StreamFinish(stream) == cJSON_ParseDone);
+    cJSON *tree = cJSON_StreamDetachTree(stream);
+    CHECK(tree && tree->valueint == 123);
+    cJSON_Delete(tree);
+    cJSON_DeleteStream(stream);
+}
+
+int main() {
+    test_splits();
+    test_after_done();
+    return test_report("stream");
+}
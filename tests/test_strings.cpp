@@ -0,0 +1,87 @@
+/*
+ * 字符串解析与输出：转义、\u 编码与代理对、SIMD 块边界附近的转义和引号、字符串往返。
+ */
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "test.hpp"
+
+/* 解析一个 JSON 字符串，返回解码后的内容；解析失败时返回 "<null>" */
+static std::string decode(const std::string &json) {
+    cJSON *item = cJSON_ParseWithLength(json.data(), json.size());
+    std::string out = item && (item->type & cJSON_String) ? item->valuestring : "<null>";
+    cJSON_Delete(item);
+    return out;
+}
+
+static void test_escapes() {
+    static const struct {
+        const char *json, *expected;
+    } cases[] = {
+            {"\"\"", ""},
+            {"\"abc\"", "abc"},
+            {"\"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\t\"", "a\"b\\c/d\b\f\n\r\t"},
+            {"\"\\u0041\\u00e9\\u20AC\"", "A\xC3\xA9\xE2\x82\xAC"},
+            {"\"\\uD83D\\uDE00\"", "\xF0\x9F\x98\x80"},             // 代理对
+            {"\"x\\ud834\\udd1ey\"", "x\xF0\x9D\x84\x9Ey"},
+            {"\"\\uDBFF\\uDFFF\"", "\xF4\x8F\xBF\xBF"},             // 最大的码点
+            {"\"\xE4\xB8\xAD\xE6\x96\x87\"", "\xE4\xB8\xAD\xE6\x96\x87"},   // UTF-8 原样保留
+            {"\"a\\uDC00b\"", "ab"},        // 单独的低位代理项被丢弃
+            {"\"a\\uD800b\"", "ab"},        // 缺少低位代理项
+            {"\"a\\u0000b\"", "ab"},        // \u0000 无法放进 C 字符串
+    };
+    for (const auto &c : cases) CHECK(decode(c.json) == c.expected);
+
+    CHECK(decode("\"abc") == "<null>");
+    CHECK(decode("\"abc\\\"") == "<null>");
+    CHECK(decode("\"\\") == "<null>");
+}
+
+/* 在不同长度、不同位置放一个转义，并让字符串从不同的对齐位置开始，覆盖 16/32 字节块的边界 */
+static void test_block_boundaries() {
+    std::string buffer, json, expected;
+    for (size_t length = 0; length < 80; length++) {
+        for (size_t at = 0; at <= length; at++) {
+            json.assign(1, '"').append(at, 'a').append("\\n").append(length - at, 'b').append(1, '"');
+            expected.assign(at, 'a').append(1, '\n').append(length - at, 'b');
+            for (size_t offset = 0; offset < 32; offset++) {
+                buffer = std::string(offset, ' ') + json;
+                CHECK(decode(buffer) == expected);
+                CHECK(decode(buffer.substr(0, buffer.size() - 1)) == "<null>");   // 没有结束的引号
+            }
+        }
+        json.assign(1, '"').append(length, 'c').append(1, '"');
+        for (size_t offset = 0; offset < 32; offset++) CHECK(decode(std::string(offset, ' ') + json) == std::string(length, 'c'));
+    }
+}
+
+/* 任意字节（不含 \0）组成的字符串经过输出和解析后不变 */
+static void test_print_roundtrip() {
+    std::mt19937 rng(3);
+    for (int i = 0; i < 20000; i++) {
+        std::string value(rng() % 70, ' ');
+        for (char &c : value) c = (char) (rng() % 255 + 1);
+        cJSON *item = cJSON_CreateString(value.c_str());
+        std::string json = print_unformatted(item);
+        CHECK(decode(json) == value);
+        cJSON_Delete(item);
+    }
+}
+
+static void test_keys() {
+    cJSON *root = cJSON_Parse("{\"a\\tb\":1,\"\\u00e9\":2,\"\\uD83D\\uDE00\":3}");
+    CHECK(cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(root, "a\tb")) == 1);
+    CHECK(cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(root, "\xC3\xA9")) == 2);
+    CHECK(cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(root, "\xF0\x9F\x98\x80")) == 3);
+    CHECK(print_unformatted(root) == "{\"a\\tb\":1,\"\xC3\xA9\":2,\"\xF0\x9F\x98\x80\":3}");
+    cJSON_Delete(root);
+}
+
+int main() {
+    test_escapes();
+    test_block_boundaries();
+    test_print_roundtrip();
+    test_keys();
+    return test_report("strings");
+}
@@ -0,0 +1,74 @@
+/*
+ * cJSON_Validate 的字符串扫描：0x00 到 0x1F 的每个控制字符放在字符串的每个位置，
+ * 输入放在相对 32 字节边界的每种偏移上，控制字符因此落在 SIMD 块之前、块内和跨过块之后，
+ * 都必须被拒绝并报告正确的位置。0x20、0x7F 和多字节 UTF-8 字符在同样的位置必须被接受。
+ */
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "test.hpp"
+
+/* 64 字节对齐的缓冲区，文本从 offset 开始 */
+class aligned_text {
+public:
+    aligned_text(const std::string &text, size_t offset) {
+        buffer = (char *) aligned_alloc(64, (offset + text.size() + 63) / 64 * 64 + 64);
+        data = buffer + offset;
+        memcpy(data, text.data(), text.size());
+        size = text.size();
+    }
+
+    ~aligned_text() { free(buffer); }
+
+    char *data;
+    size_t size;
+
+private:
+    char *buffer;
+};
+
+/* 在 length 个 'a' 组成的字符串值的 pos 处放入 insert，key 为真时放在对象的键中 */
+static std::string with_byte(size_t length, size_t pos, const std::string &insert, bool key) {
+    std::string json(key ? "{\"" : "[\"");
+    json.append(pos, 'a').append(insert).append(length - pos - 1, 'a');
+    return json.append(key ? "\":1}" : "\"]");
+}
+
+static void test_control_characters() {
+    const size_t length = 80;
+    cJSON_Error error;
+    for (int c = 0; c < 0x20; c++) {
+        for (size_t pos = 0; pos < length; pos++) {
+            for (size_t offset = 0; offset < 32; offset++) {
+                for (bool key : {false, true}) {
+                    std::string json = with_byte(length, pos, std::string(1, (char) c), key);
+                    aligned_text text(json, offset);
+                    CHECK(!cJSON_Validate(text.data, text.size, &error));
+                    CHECK(error.code == cJSON_ErrorSyntax && error.offset == pos + 2);
+                }
+            }
+        }
+    }
+}
+
+static void test_accepted() {
+    const size_t length = 80;
+    cJSON_Error error;
+    for (const char *insert : {" ", "\x7F", "\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80"}) {
+        for (size_t pos = 0; pos < length; pos++) {
+            for (size_t offset = 0; offset < 32; offset++) {
+                std::string json = with_byte(length, pos, insert, offset & 1);
+                aligned_text text(json, offset);
+                CHECK(cJSON_Validate(text.data, text.size, &error));
+                CHECK(error.code == cJSON_ErrorNone);
+            }
+        }
+    }
+}
+
+int main() {
+    test_control_characters();
+    test_accepted();
+    return test_report("validate");
+}